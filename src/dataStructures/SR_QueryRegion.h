@@ -204,6 +204,25 @@ static inline void SR_QueryRegionSetRangeSpecial(SR_QueryRegion* pQueryRegion, u
     pQueryRegion->farRefEnd = specialRefLen - 1;
 }
 
+//==============================================================
+// function:
+//      set the search region to a single reference window for
+//      the split aligner
+//
+// args:
+//      1. pQueryRegion: a pointer to an query region structure
+//      2. refBegin: the first position of the window
+//      3. refEnd: the last position of the window
+//==============================================================
+static inline void SR_QueryRegionSetRangeWindow(SR_QueryRegion* pQueryRegion, uint32_t refBegin, uint32_t refEnd) 
+{
+    pQueryRegion->closeRefBegin = refBegin;
+    pQueryRegion->closeRefEnd = refEnd;
+
+    pQueryRegion->farRefBegin = refBegin;
+    pQueryRegion->farRefEnd = refEnd;
+}
+
 #endif  /*SR_QUERYREGION_H*/
 
 
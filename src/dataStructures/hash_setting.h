@@ -0,0 +1,19 @@
+#ifndef DATASTRUCTURES_HASH_SETTING_H_
+#define DATASTRUCTURES_HASH_SETTING_H_
+
+namespace Scissors {
+struct HashSetting {
+  int minimizer_window;  // only index (w,k)-minimizers; 1 indexes every position
+  int hash_size;         // hash size of the reference hash table
+  int special_hash_size; // hash size of the special reference hash table
+  int max_occurrence;    // mask hashes occurring more often; 0 disables masking
+
+  HashSetting()
+      : minimizer_window(1)
+      , hash_size(7)
+      , special_hash_size(7)
+      , max_occurrence(0)
+  {}
+};
+} // namespace
+#endif // DATASTRUCTURES_HASH_SETTING_H_
@@ -6,11 +6,42 @@ struct TargetRegion {
   int fragment_length;
   int local_window_size;
   int discovery_window_size;
+  // Reference bases kept on each side of the seed diagonal when
+  //  the local window is narrowed by seeds; 0 aligns whole windows.
+  int local_seed_band;
+  // The X-drop of the ungapped extension of the local seeds, which
+  //  replaces SSW when it passes the filters; 0 always runs SSW.
+  int ungapped_xdrop;
+  // Medium-sized indels are found by joining two ungapped pieces
+  //  at one gap instead of by SSW.
+  bool split_indel_dp;
+  // Orphans are aligned to the junctions of the medium-sized indels found
+  //  before in their windows, and searched in full only if none fits.
+  bool junction_cache;
+  // The special-reference searches are skipped when the medium-sized indel
+  //  alignment, or the first partial, aligns at least this rate of the
+  //  orphan; 0 never skips.
+  float decisive_indel_rate;
+  float decisive_local_rate;
+
+  // The interval given by -r; region_id < 0 means the whole bam is processed.
+  int region_id;
+  int region_begin;
+  int region_end;
 
   TargetRegion()
       : fragment_length(0)
       , local_window_size(1000)
       , discovery_window_size(10000)
+      , local_seed_band(0)
+      , ungapped_xdrop(0)
+      , split_indel_dp(false)
+      , junction_cache(false)
+      , decisive_indel_rate(0.0)
+      , decisive_local_rate(0.0)
+      , region_id(-1)
+      , region_begin(0)
+      , region_end(0)
   {}
 };
 } // namespace
@@ -0,0 +1,319 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "utilities/hashTable/SR_HashRegionTable.h"
+#include "utilities/hashTable/SR_InHashTable.h"
+}
+
+using std::map;
+using std::string;
+using std::vector;
+
+namespace {
+
+string MakeSequence(const unsigned int& length) {
+  const char bases[] = "ACGT";
+  string seq(length, 'A');
+  for (unsigned int i = 0; i < length; ++i) seq[i] = bases[rand() % 4];
+  return seq;
+}
+
+// A read that takes pieces of the reference with a few mismatches, so that
+// its hits fall on several diagonals and break on some of them
+string MakeRead(const string& reference, const unsigned int& length) {
+  string read;
+  while (read.size() < length) {
+    const unsigned int piece = 15 + rand() % 30;
+    const unsigned int begin = rand() % (reference.size() - piece);
+    read += reference.substr(begin, piece);
+  }
+  read.resize(length);
+  for (unsigned int i = 0; i < length / 20; ++i) read[rand() % length] = "ACGTN"[rand() % 5];
+  return read;
+}
+
+string GetReverseComplement(const string& seq) {
+  string rev_comp(seq.rbegin(), seq.rend());
+  for (unsigned int i = 0; i < rev_comp.size(); ++i) {
+    switch (rev_comp[i]) {
+      case 'A': rev_comp[i] = 'T'; break;
+      case 'C': rev_comp[i] = 'G'; break;
+      case 'G': rev_comp[i] = 'C'; break;
+      case 'T': rev_comp[i] = 'A'; break;
+      default: break;
+    }
+  }
+  return rev_comp;
+}
+
+// Holds a query region whose orphan is read, searched in the given ranges;
+// the reverse complement of the orphan is set as SR_QueryRegionLoadSeq sets it
+class Query {
+ public:
+  Query(const string& read, const uint32_t& close_begin, const uint32_t& close_end,
+        const uint32_t& far_begin, const uint32_t& far_end)
+      : read_(read)
+      , rev_comp_(GetReverseComplement(read))
+      , region_(SR_QueryRegionAlloc()) {
+    memset(&orphan_, 0, sizeof(orphan_));
+    SR_SetQueryLen(&orphan_, read_.size());
+    region_->pOrphan = &orphan_;
+    region_->orphanSeq = region_->orphanSeqForward = &read_[0];
+    region_->orphanSeqReverseComplament = &rev_comp_[0];
+    region_->closeRefBegin = close_begin;
+    region_->closeRefEnd = close_end;
+    region_->farRefBegin = far_begin;
+    region_->farRefEnd = far_end;
+  }
+  ~Query() {
+    region_->orphanSeq = region_->orphanSeqForward = region_->orphanSeqReverseComplament = NULL;
+    SR_QueryRegionFree(region_);
+  }
+  const SR_QueryRegion* Get(void) const {return region_;}
+
+ private:
+  string read_;
+  string rev_comp_;
+  bam1_t orphan_;
+  SR_QueryRegion* region_;
+
+  Query (const Query&);
+  Query& operator= (const Query&);
+};
+
+// HashRegionTableLoad done with a map of the regions on each diagonal
+void LoadNaively(const SR_InHashTable* table, const string& read, const SR_QueryRegion& query,
+                 vector<BestRegion>* close, vector<BestRegion>* far) {
+  BestRegion empty;
+  memset(&empty, 0, sizeof(empty));
+  close->assign(read.size(), empty);
+  far->assign(read.size(), empty);
+  for (unsigned int i = 0; i < read.size(); ++i) (*close)[i].queryBegin = (*far)[i].queryBegin = i;
+
+  struct Open {uint32_t last; HashRegion region;};
+  map<int64_t, Open> open;
+  const string codes = "ACGT";
+  for (unsigned int q = 0; q + table->hashSize <= read.size(); ++q) {
+    uint64_t key = 0;
+    bool valid = true;
+    for (unsigned int i = q; i < q + table->hashSize; ++i) {
+      const size_t code = codes.find(read[i]);
+      if (code == string::npos) valid = false;
+      key = (key << 2) | (code & 3);
+    }
+    HashPosView view;
+    if (!valid || !SR_InHashTableSearch(&view, table, key)) continue;
+
+    for (unsigned int i = 0; i < view.size; ++i) {
+      const uint32_t pos = view.data[i];
+      if (pos < query.farRefBegin || pos > query.farRefEnd) continue;
+      const int64_t diagonal = static_cast<int64_t>(pos) - q;
+      map<int64_t, Open>::iterator ite = open.find(diagonal);
+      if (ite != open.end() && ite->second.last + 1 == q) {
+        ++ite->second.region.length;
+      } else {
+        Open& entry = open[diagonal];
+        entry.region.queryBegin = q;
+        entry.region.refBegin = pos;
+        entry.region.length = table->hashSize;
+        ite = open.find(diagonal);
+      }
+      ite->second.last = q;
+
+      const HashRegion& region = ite->second.region;
+      vector<BestRegion>* bests[] = {far, close};
+      for (int b = 0; b < 2; ++b) {
+        if (b == 1 && (region.refBegin < query.closeRefBegin || region.refBegin > query.closeRefEnd))
+          continue;
+        BestRegion& best = (*bests[b])[region.queryBegin];
+        if (region.length > best.length) {
+          best.length = region.length;
+          best.refBegins[0] = region.refBegin;
+          best.numPos = 1;
+        } else if (region.length == best.length) {
+          if (best.numPos < MAX_BEST_REF_BEGINS) best.refBegins[best.numPos] = region.refBegin;
+          ++best.numPos;
+        }
+      }
+    }
+  }
+}
+
+void ExpectSameRegions(const vector<BestRegion>& expect, const BestRegionArray& actual) {
+  ASSERT_EQ(expect.size(), actual.size);
+  for (unsigned int i = 0; i < expect.size(); ++i) {
+    const BestRegion& region = actual.data[i];
+    EXPECT_EQ(expect[i].queryBegin, region.queryBegin) << "at " << i;
+    EXPECT_EQ(expect[i].length, region.length) << "at " << i;
+    EXPECT_EQ(expect[i].numPos, region.numPos) << "at " << i;
+    if (expect[i].length == 0) continue;
+    const unsigned int kept = expect[i].numPos < MAX_BEST_REF_BEGINS ? expect[i].numPos : MAX_BEST_REF_BEGINS;
+    for (unsigned int j = 0; j < kept; ++j)
+      EXPECT_EQ(expect[i].refBegins[j], region.refBegins[j]) << "at " << i;
+  }
+}
+
+// Hits merge on their diagonals as a map of the open regions merges them,
+// also when a table is reused for many reads and its open regions grow
+TEST(HashRegionTableTest, DiagonalMerge) {
+  srand(32);
+  const string reference = MakeSequence(3000) + MakeSequence(40) + MakeSequence(40);
+  // repeats put the hits of a read on many diagonals
+  string dinucleotide;
+  for (unsigned int i = 0; i < 400; ++i) dinucleotide += "AC";
+  const string repeated = reference + reference.substr(200, 400) + reference.substr(200, 400)
+      + dinucleotide;
+  SR_InHashTable* table = SR_InHashTableAllocSorted(8);
+  SR_InHashTableLoad(table, repeated.c_str(), repeated.size(), 0, 1);
+
+  HashRegionTable* region_table = HashRegionTableAlloc();
+  for (unsigned int r = 0; r < 50; ++r) {
+    string read = MakeRead(repeated, 60 + rand() % 140);
+    if (r % 10 == 1) read.replace(10, 40, dinucleotide.substr(0, 40));
+    const bool whole = r % 5 == 0 || r % 10 == 1;
+    const uint32_t far_begin = whole ? 0 : rand() % 1000;
+    const uint32_t far_end = whole ? repeated.size() : far_begin + 1500 + rand() % 1500;
+    const uint32_t close_begin = far_begin + rand() % 300;
+    Query query(read, close_begin, close_begin + 800, far_begin, far_end);
+
+    HashRegionTableInit(region_table, read.size());
+    HashRegionTableLoad(region_table, table, query.Get());
+
+    vector<BestRegion> close, far;
+    LoadNaively(table, read, *query.Get(), &close, &far);
+    ExpectSameRegions(close, *region_table->pBestCloseRegions);
+    ExpectSameRegions(far, *region_table->pBestFarRegions);
+  }
+  // the dinucleotide reads opened more regions than the table had slots
+  EXPECT_GT(region_table->openRegions.capacity, 256u);
+
+  HashRegionTableFree(region_table);
+  SR_InHashTableFree(table);
+}
+
+bool IsLonger(const BestRegion* first, const BestRegion* second) {
+  if (first->length != second->length) return first->length > second->length;
+  return first->queryBegin < second->queryBegin;
+}
+
+// The top regions are the longest close regions, longest first, as sorting
+// all of them gives; a reused table starts every read from cleared regions
+TEST(HashRegionTableTest, TopRegions) {
+  srand(35);
+  const string reference = MakeSequence(2000);
+  const string repeated = reference + reference.substr(500, 300) + reference.substr(500, 300);
+  SR_InHashTable* table = SR_InHashTableAllocSorted(8);
+  SR_InHashTableLoad(table, repeated.c_str(), repeated.size(), 0, 1);
+
+  HashRegionTable* reused = HashRegionTableAlloc();
+  for (unsigned int r = 0; r < 100; ++r) {
+    // long reads first so that later reads leave stale entries behind them
+    const string read = MakeRead(repeated, r < 5 ? 300 : 40 + rand() % 160);
+    const uint32_t close_begin = rand() % 1500;
+    Query query(read, close_begin, close_begin + 1000, 0, repeated.size());
+
+    HashRegionTableInit(reused, read.size());
+    HashRegionTableLoad(reused, table, query.Get());
+
+    HashRegionTable* fresh = HashRegionTableAlloc();
+    HashRegionTableInit(fresh, read.size());
+    HashRegionTableLoad(fresh, table, query.Get());
+    vector<BestRegion> close(fresh->pBestCloseRegions->data,
+                             fresh->pBestCloseRegions->data + fresh->pBestCloseRegions->size);
+    vector<BestRegion> far(fresh->pBestFarRegions->data,
+                           fresh->pBestFarRegions->data + fresh->pBestFarRegions->size);
+    ExpectSameRegions(close, *reused->pBestCloseRegions);
+    ExpectSameRegions(far, *reused->pBestFarRegions);
+    HashRegionTableFree(fresh);
+
+    vector<const BestRegion*> sorted;
+    for (unsigned int i = 0; i < reused->pBestCloseRegions->size; ++i)
+      if (reused->pBestCloseRegions->data[i].length > 0)
+        sorted.push_back(reused->pBestCloseRegions->data + i);
+    std::sort(sorted.begin(), sorted.end(), IsLonger);
+    if (sorted.size() > MAX_TOP_REGIONS) sorted.resize(MAX_TOP_REGIONS);
+
+    ASSERT_EQ(sorted.size(), reused->numTopRegions);
+    for (unsigned int i = 0; i < sorted.size(); ++i)
+      EXPECT_EQ(sorted[i], reused->pTopRegions[i]) << "top " << i;
+  }
+
+  HashRegionTableFree(reused);
+  SR_InHashTableFree(table);
+}
+
+void ExpectSameTopRegions(const HashRegionTable& expect, const HashRegionTable& actual) {
+  ASSERT_EQ(expect.numTopRegions, actual.numTopRegions);
+  for (unsigned int i = 0; i < expect.numTopRegions; ++i) {
+    const BestRegion& expect_region = *expect.pTopRegions[i];
+    const BestRegion& region = *actual.pTopRegions[i];
+    EXPECT_EQ(expect_region.queryBegin, region.queryBegin) << "top " << i;
+    EXPECT_EQ(expect_region.length, region.length) << "top " << i;
+    EXPECT_EQ(expect_region.numPos, region.numPos) << "top " << i;
+    EXPECT_EQ(expect_region.refBegins[0], region.refBegins[0]) << "top " << i;
+  }
+}
+
+// Seeding a read and its reverse complement in one pass gives the regions
+// of seeding each of them alone, for full and for minimizer tables
+TEST(HashRegionTableTest, BothStrands) {
+  srand(50);
+  const string reference = MakeSequence(3000);
+  // the reverse complement of a piece, so that reads hit on both strands
+  const string repeated = reference + GetReverseComplement(reference.substr(800, 400));
+  const unsigned char window_sizes[] = {1, 5};
+  for (unsigned int w = 0; w < sizeof(window_sizes) / sizeof(window_sizes[0]); ++w) {
+    SR_InHashTable* table = SR_InHashTableAllocSorted(9);
+    SR_InHashTableLoad(table, repeated.c_str(), repeated.size(), 0, window_sizes[w]);
+
+    HashRegionTable* forward = HashRegionTableAlloc();
+    HashRegionTable* rev_comp = HashRegionTableAlloc();
+    HashRegionTable* expect = HashRegionTableAlloc();
+    unsigned int forward_hits = 0, rev_comp_hits = 0;
+    for (unsigned int r = 0; r < 60; ++r) {
+      string read = MakeRead(repeated, 50 + rand() % 150);
+      if (r % 3 == 0) read = GetReverseComplement(read);
+      const uint32_t close_begin = rand() % 2000;
+      Query query(read, close_begin, close_begin + 1500, 0, repeated.size());
+      Query rev_comp_query(GetReverseComplement(read), close_begin, close_begin + 1500,
+                           0, repeated.size());
+
+      HashRegionTableInit(forward, read.size());
+      HashRegionTableInit(rev_comp, read.size());
+      HashRegionTableLoadBothStrands(forward, rev_comp, table, query.Get());
+      if (forward->numTopRegions > 0) ++forward_hits;
+      if (rev_comp->numTopRegions > 0) ++rev_comp_hits;
+
+      HashRegionTableInit(expect, read.size());
+      HashRegionTableLoad(expect, table, query.Get());
+      ExpectSameRegions(vector<BestRegion>(expect->pBestCloseRegions->data,
+                            expect->pBestCloseRegions->data + expect->pBestCloseRegions->size),
+                        *forward->pBestCloseRegions);
+      ExpectSameTopRegions(*expect, *forward);
+
+      HashRegionTableInit(expect, read.size());
+      HashRegionTableLoad(expect, table, rev_comp_query.Get());
+      ExpectSameRegions(vector<BestRegion>(expect->pBestFarRegions->data,
+                            expect->pBestFarRegions->data + expect->pBestFarRegions->size),
+                        *rev_comp->pBestFarRegions);
+      ExpectSameTopRegions(*expect, *rev_comp);
+    }
+    EXPECT_GT(forward_hits, 0u);
+    EXPECT_GT(rev_comp_hits, 0u);
+
+    HashRegionTableFree(forward);
+    HashRegionTableFree(rev_comp);
+    HashRegionTableFree(expect);
+    SR_InHashTableFree(table);
+  }
+}
+} // namespace
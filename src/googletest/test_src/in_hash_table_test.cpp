@@ -0,0 +1,236 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "utilities/hashTable/SR_InHashTable.h"
+}
+
+using std::map;
+using std::string;
+using std::vector;
+
+namespace {
+
+typedef map<uint64_t, vector<uint32_t> > PositionMap;
+
+// A random reference with a few N runs and a repeated stretch
+string MakeReference(const unsigned int& length, const unsigned int& seed) {
+  srand(seed);
+  const char bases[] = "ACGT";
+  string reference(length, 'A');
+  for (unsigned int i = 0; i < length; ++i) reference[i] = bases[rand() % 4];
+  for (unsigned int i = 0; i + 3 < length; i += length / 5) reference.replace(i, 3, "NNN");
+  if (length > 400) reference.replace(300, 60, reference.substr(100, 60));
+  return reference;
+}
+
+// The hash key of a hash, or false if it has an N
+bool GetKey(const string& seq, const unsigned int& begin, const unsigned int& hash_size,
+            uint64_t* key) {
+  const string codes = "ACGT";
+  *key = 0;
+  for (unsigned int i = begin; i < begin + hash_size; ++i) {
+    const size_t code = codes.find(seq[i]);
+    if (code == string::npos) return false;
+    *key = (*key << 2) | code;
+  }
+  return true;
+}
+
+// Every position of every hash of seq, found one by one
+void GetPositions(const string& seq, const unsigned int& hash_size, PositionMap* positions) {
+  positions->clear();
+  uint64_t key = 0;
+  for (unsigned int i = 0; i + hash_size <= seq.size(); ++i)
+    if (GetKey(seq, i, hash_size, &key)) (*positions)[key].push_back(i);
+}
+
+// A dense table (hash_size <= MAX_HASH_SIZE) filled as SR_InHashTableRead fills it
+SR_InHashTable* LoadDenseTable(const string& seq, const unsigned int& hash_size) {
+  PositionMap positions;
+  GetPositions(seq, hash_size, &positions);
+
+  SR_InHashTable* table = SR_InHashTableAlloc(hash_size);
+  vector<uint32_t> hash_pos;
+  for (uint64_t key = 0; key < table->numHashes; ++key) {
+    table->indices[key] = hash_pos.size();
+    PositionMap::const_iterator ite = positions.find(key);
+    if (ite != positions.end())
+      hash_pos.insert(hash_pos.end(), ite->second.begin(), ite->second.end());
+  }
+
+  table->numPos = hash_pos.size();
+  table->hashPos = static_cast<uint32_t*>(malloc(sizeof(uint32_t) * (hash_pos.size() + 1)));
+  for (unsigned int i = 0; i < hash_pos.size(); ++i) table->hashPos[i] = hash_pos[i];
+  SR_InHashTableMask(table, 0);
+  return table;
+}
+
+// Positions found by SR_InHashTableSearch; empty if the hash is not found
+vector<uint32_t> Search(const SR_InHashTable* table, const uint64_t& key) {
+  HashPosView view;
+  if (!SR_InHashTableSearch(&view, table, key)) return vector<uint32_t>();
+  return vector<uint32_t>(view.data, view.data + view.size);
+}
+
+// Positions found by SR_InHashTableSearchRange in [begin, end]
+vector<uint32_t> SearchRange(const SR_InHashTable* table, const uint64_t& key,
+                             const uint32_t& begin, const uint32_t& end, bool* found) {
+  HashPosView view;
+  *found = SR_InHashTableSearchRange(&view, table, key, begin, end);
+  if (!*found) return vector<uint32_t>();
+  return vector<uint32_t>(view.data, view.data + view.size);
+}
+
+void ExpectSamePositions(const PositionMap& expect, const SR_InHashTable* table) {
+  for (PositionMap::const_iterator ite = expect.begin(); ite != expect.end(); ++ite)
+    EXPECT_EQ(ite->second, Search(table, ite->first)) << "key " << ite->first;
+}
+
+// Hashes longer than MAX_HASH_SIZE go through the 64-bit sorted key directory
+TEST(InHashTableTest, LongHashes) {
+  const string reference = MakeReference(2000, 29);
+  const unsigned int hash_sizes[] = {13, 20, 31};
+  for (unsigned int h = 0; h < sizeof(hash_sizes) / sizeof(hash_sizes[0]); ++h) {
+    PositionMap positions;
+    GetPositions(reference, hash_sizes[h], &positions);
+
+    SR_InHashTable* table = SR_InHashTableAlloc(hash_sizes[h]);
+    SR_InHashTableLoad(table, reference.c_str(), reference.size(), 0, 1);
+    ASSERT_TRUE(table->keys != NULL);
+    EXPECT_EQ(positions.size(), table->numHashes);
+    ExpectSamePositions(positions, table);
+
+    // keys that are not in the reference, including the largest one
+    const uint64_t largest = (static_cast<uint64_t>(1) << (2 * hash_sizes[h])) - 1;
+    const uint64_t absent[] = {0, largest, largest / 3};
+    for (unsigned int i = 0; i < sizeof(absent) / sizeof(absent[0]); ++i) {
+      if (positions.find(absent[i]) == positions.end()) {
+        EXPECT_TRUE(Search(table, absent[i]).empty());
+      }
+    }
+
+    SR_InHashTableFree(table);
+  }
+}
+
+// A sorted key directory gives the same hits as the dense index
+TEST(InHashTableTest, SortedMatchesDense) {
+  const string reference = MakeReference(3000, 30);
+  const unsigned int hash_size = 7;
+  SR_InHashTable* dense = LoadDenseTable(reference, hash_size);
+  SR_InHashTable* sorted = SR_InHashTableAllocSorted(hash_size);
+  SR_InHashTableLoad(sorted, reference.c_str(), reference.size(), 0, 1);
+
+  ASSERT_TRUE(dense->keys == NULL);
+  ASSERT_TRUE(sorted->keys != NULL);
+  EXPECT_EQ(dense->numPos, sorted->numPos);
+  for (uint64_t key = 0; key < dense->numHashes; ++key)
+    EXPECT_EQ(Search(dense, key), Search(sorted, key)) << "key " << key;
+
+  SR_InHashTableFree(dense);
+  SR_InHashTableFree(sorted);
+}
+
+// Hashes above the occurrence cap lose their positions and are reported as masked
+TEST(InHashTableTest, Masking) {
+  // the 5-mers of a poly-A run and a repeated motif occur many times
+  const string reference = MakeReference(1500, 31) + string(40, 'A') + "ACGTTACGTTACGTTACGTT";
+  const unsigned int hash_size = 5;
+  const unsigned int max_occurrence = 4;
+  PositionMap positions;
+  GetPositions(reference, hash_size, &positions);
+
+  SR_InHashTable* dense = LoadDenseTable(reference, hash_size);
+  SR_InHashTable* sorted = SR_InHashTableAllocSorted(hash_size);
+  SR_InHashTableLoad(sorted, reference.c_str(), reference.size(), 0, 1);
+  SR_InHashTable* tables[] = {dense, sorted};
+  for (unsigned int t = 0; t < 2; ++t) {
+    SR_InHashTable* table = tables[t];
+    SR_InHashTableMask(table, max_occurrence);
+
+    unsigned int masked_hashes = 0, masked_pos = 0, kept_pos = 0;
+    for (PositionMap::const_iterator ite = positions.begin(); ite != positions.end(); ++ite) {
+      if (ite->second.size() > max_occurrence) {
+        ++masked_hashes;
+        masked_pos += ite->second.size();
+        EXPECT_TRUE(Search(table, ite->first).empty());
+        EXPECT_TRUE(SR_InHashTableIsMasked(table, ite->first));
+      } else {
+        kept_pos += ite->second.size();
+        EXPECT_EQ(ite->second, Search(table, ite->first));
+        EXPECT_FALSE(SR_InHashTableIsMasked(table, ite->first));
+      }
+    }
+    ASSERT_GT(masked_hashes, 0u);
+    EXPECT_EQ(masked_hashes, table->numMaskedHashes);
+    EXPECT_EQ(masked_pos, table->numMaskedPos);
+    EXPECT_EQ(kept_pos, table->numPos);
+
+    // 0 turns masking off again for a freshly loaded table
+    SR_InHashTableMask(table, 0);
+    EXPECT_TRUE(table->maskedBits == NULL);
+    EXPECT_EQ(0u, table->numMaskedHashes);
+  }
+
+  // an absent hash is not masked
+  uint64_t absent = 0;
+  while (positions.find(absent) != positions.end()) ++absent;
+  EXPECT_FALSE(SR_InHashTableIsMasked(dense, absent));
+
+  SR_InHashTableFree(dense);
+  SR_InHashTableFree(sorted);
+}
+
+// SR_InHashTableSearchRange gives the positions of a hash in the window
+TEST(InHashTableTest, SearchRange) {
+  // short hashes so that each of them has many positions
+  const string reference = MakeReference(20000, 32);
+  const unsigned int hash_size = 4;
+  PositionMap positions;
+  GetPositions(reference, hash_size, &positions);
+
+  SR_InHashTable* table = LoadDenseTable(reference, hash_size);
+
+  srand(33);
+  for (PositionMap::const_iterator ite = positions.begin(); ite != positions.end(); ++ite) {
+    for (unsigned int w = 0; w < 20; ++w) {
+      uint32_t begin = rand() % (reference.size() + 100);
+      uint32_t end = begin + rand() % 500;
+      if (w == 0) {begin = 0; end = reference.size();}  // the whole reference
+      if (w == 1) end = begin;                          // a single base
+      if (w == 2) {begin = ite->second[0]; end = ite->second.back();}
+
+      vector<uint32_t> expect;
+      for (unsigned int i = 0; i < ite->second.size(); ++i)
+        if (ite->second[i] >= begin && ite->second[i] <= end) expect.push_back(ite->second[i]);
+
+      bool found = false;
+      EXPECT_EQ(expect, SearchRange(table, ite->first, begin, end, &found));
+      EXPECT_TRUE(found);
+    }
+  }
+
+  // a window before its begin is empty; a hash that is absent is not found
+  bool found = true;
+  EXPECT_TRUE(SearchRange(table, positions.begin()->first, 10, 5, &found).empty());
+  EXPECT_TRUE(found);
+  const string long_reference = MakeReference(3000, 34);
+  PositionMap long_positions;
+  GetPositions(long_reference, 10, &long_positions);
+  uint64_t absent = 0;
+  while (long_positions.find(absent) != long_positions.end()) ++absent;
+  SR_InHashTable* long_table = LoadDenseTable(long_reference, 10);
+  EXPECT_TRUE(SearchRange(long_table, absent, 0, long_reference.size(), &found).empty());
+  EXPECT_FALSE(found);
+
+  SR_InHashTableFree(table);
+  SR_InHashTableFree(long_table);
+}
+} // namespace
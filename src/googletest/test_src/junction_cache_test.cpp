@@ -0,0 +1,111 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "utilities/miscellaneous/junction_cache.h"
+
+using std::string;
+using std::vector;
+using Scissors::JunctionCache;
+
+namespace {
+
+JunctionCache::Junction MakeJunction(const int32_t& ref_id, const int& position,
+                                     const bool& insertion, const int& length,
+                                     const string& sequence) {
+  JunctionCache::Junction junction;
+  junction.ref_id    = ref_id;
+  junction.begin     = position - 50;
+  junction.position  = position;
+  junction.insertion = insertion;
+  junction.length    = length;
+  junction.sequence  = sequence;
+  const string codes = "ACGT";
+  for (unsigned int i = 0; i < sequence.size(); ++i) {
+    const size_t code = codes.find(sequence[i]);
+    junction.translated.push_back(code == string::npos ? 4 : code);
+  }
+  return junction;
+}
+
+vector<int> GetPositions(const JunctionCache& cache, const int32_t& ref_id,
+                         const int& begin, const int& end) {
+  vector<const JunctionCache::Junction*> junctions;
+  cache.Get(ref_id, begin, end, &junctions);
+  vector<int> positions;
+  for (unsigned int i = 0; i < junctions.size(); ++i) positions.push_back(junctions[i]->position);
+  return positions;
+}
+
+const char kSequence[] = "TTGACCATGACGTTAGCATCGATCGGATCCATGGCATTACGATCAGTCAGTTGCAAT";
+
+// The same junction is kept once; a junction that differs in anything is kept
+TEST(JunctionCacheTest, AddDedup) {
+  JunctionCache cache;
+  EXPECT_TRUE(cache.Add(MakeJunction(0, 1000, true, 5, kSequence)));
+  EXPECT_FALSE(cache.Add(MakeJunction(0, 1000, true, 5, kSequence)));
+  EXPECT_EQ(1u, cache.GetSize());
+
+  string other = kSequence;
+  other[10] = 'A';
+  EXPECT_TRUE(cache.Add(MakeJunction(0, 1000, true, 5, other)));
+  EXPECT_TRUE(cache.Add(MakeJunction(0, 1000, false, 5, kSequence)));
+  EXPECT_TRUE(cache.Add(MakeJunction(0, 1000, true, 6, kSequence)));
+  EXPECT_TRUE(cache.Add(MakeJunction(0, 1001, true, 5, kSequence)));
+  EXPECT_TRUE(cache.Add(MakeJunction(1, 1000, true, 5, kSequence)));
+  EXPECT_EQ(6u, cache.GetSize());
+  // a copy of one that is not first at its breakpoint is found as well
+  EXPECT_FALSE(cache.Add(MakeJunction(0, 1000, true, 6, kSequence)));
+  EXPECT_EQ(6u, cache.GetSize());
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.GetSize());
+  EXPECT_TRUE(cache.Add(MakeJunction(0, 1000, true, 5, kSequence)));
+}
+
+// Get gives the junctions of a chromosome whose breakpoints are in
+// [begin, end], in the order of their breakpoints
+TEST(JunctionCacheTest, GetRange) {
+  JunctionCache cache;
+  const int positions[] = {700, 100, 400, 400, 1000, 250};
+  for (unsigned int i = 0; i < sizeof(positions) / sizeof(positions[0]); ++i)
+    cache.Add(MakeJunction(3, positions[i], true, 1 + i, kSequence));
+  cache.Add(MakeJunction(4, 400, true, 1, kSequence));
+
+  const int all[] = {100, 250, 400, 400, 700, 1000};
+  EXPECT_EQ(vector<int>(all, all + 6), GetPositions(cache, 3, 0, 2000));
+  // the ends are included
+  const int middle[] = {250, 400, 400, 700};
+  EXPECT_EQ(vector<int>(middle, middle + 4), GetPositions(cache, 3, 250, 700));
+  EXPECT_EQ(vector<int>(1, 400), GetPositions(cache, 4, 400, 400));
+  EXPECT_TRUE(GetPositions(cache, 3, 401, 699).empty());
+  EXPECT_TRUE(GetPositions(cache, 3, 1001, 5000).empty());
+  EXPECT_TRUE(GetPositions(cache, 3, 700, 600).empty());
+  EXPECT_TRUE(GetPositions(cache, 5, 0, 2000).empty());
+}
+
+// A read taken from a junction shares seeds with it on its own diagonal
+TEST(JunctionCacheTest, Diagonals) {
+  JunctionCache cache;
+  cache.Add(MakeJunction(0, 1000, true, 5, kSequence));
+  vector<const JunctionCache::Junction*> junctions;
+  cache.Get(0, 1000, 1000, &junctions);
+  ASSERT_EQ(1u, junctions.size());
+
+  // bases 9 to 48 of the junction, with an N that breaks some seeds
+  string read = string(kSequence).substr(9, 40);
+  read[20] = 'N';
+  const JunctionCache::Junction read_junction = MakeJunction(0, 0, true, 0, read);
+  vector<int32_t> seeds;
+  JunctionCache::GetSeeds(&read_junction.translated[0], read.size(), &seeds);
+  ASSERT_EQ(read.size() - JunctionCache::kSeedSize + 1, seeds.size());
+  EXPECT_EQ(-1, seeds[20]);
+  EXPECT_EQ(-1, seeds[20 - JunctionCache::kSeedSize + 1]);
+  EXPECT_NE(-1, seeds[20 - JunctionCache::kSeedSize]);
+
+  vector<int> diagonals;
+  JunctionCache::GetDiagonals(*junctions[0], seeds, &diagonals);
+  EXPECT_EQ(vector<int>(1, 9), diagonals);
+}
+} // namespace
@@ -0,0 +1,116 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "utilities/hashTable/SR_KmerFilter.h"
+}
+
+using std::set;
+using std::string;
+
+namespace {
+
+string MakeSequence(const unsigned int& length) {
+  const char bases[] = "ACGT";
+  string seq(length, 'A');
+  for (unsigned int i = 0; i < length; ++i) seq[i] = bases[rand() % 4];
+  return seq;
+}
+
+// The hashes of seq without an N
+set<string> GetHashes(const string& seq, const unsigned int& hash_size) {
+  set<string> hashes;
+  for (unsigned int i = 0; i + hash_size <= seq.size(); ++i) {
+    const string hash = seq.substr(i, hash_size);
+    if (hash.find('N') == string::npos) hashes.insert(hash);
+  }
+  return hashes;
+}
+
+bool SharesHash(const set<string>& hashes, const string& seq, const unsigned int& hash_size) {
+  const set<string> seq_hashes = GetHashes(seq, hash_size);
+  for (set<string>::const_iterator ite = seq_hashes.begin(); ite != seq_hashes.end(); ++ite)
+    if (hashes.count(*ite) > 0) return true;
+  return false;
+}
+
+bool MayContain(SR_KmerFilter* filter, const string& seq) {
+  return SR_KmerFilterMayContain(filter, seq.c_str(), seq.size()) == TRUE;
+}
+
+// A sequence sharing a hash with the reference always passes; one sharing
+// none never passes a direct filter and seldom passes a Bloom filter
+TEST(KmerFilterTest, NoFalseNegatives) {
+  srand(49);
+  string reference = MakeSequence(5000);
+  for (unsigned int i = 500; i < reference.size(); i += 1000) reference.replace(i, 4, "NNNN");
+
+  const unsigned int hash_sizes[] = {8, 11, 12, 13, 20, 31};
+  for (unsigned int h = 0; h < sizeof(hash_sizes) / sizeof(hash_sizes[0]); ++h) {
+    const unsigned int hash_size = hash_sizes[h];
+    const bool direct = hash_size <= MAX_DIRECT_FILTER_HASH_SIZE;
+    SR_KmerFilter* filter = SR_KmerFilterAlloc();
+    SR_KmerFilterLoad(filter, reference.c_str(), reference.size(), hash_size);
+    EXPECT_EQ(direct ? 0 : 3, filter->numProbes);
+    const set<string> hashes = GetHashes(reference, hash_size);
+
+    unsigned int unshared = 0, passed = 0;
+    for (unsigned int r = 0; r < 2000; ++r) {
+      // short random reads, half of them with a hash of the reference
+      string read = MakeSequence(hash_size + rand() % 10);
+      if (r % 2 == 0) {
+        const unsigned int begin = rand() % (reference.size() - hash_size);
+        read.replace(rand() % (read.size() - hash_size + 1), hash_size,
+                     reference.substr(begin, hash_size));
+      }
+      if (SharesHash(hashes, read, hash_size)) {
+        ASSERT_TRUE(MayContain(filter, read)) << "hash size " << hash_size << ", " << read;
+      } else {
+        ++unshared;
+        if (MayContain(filter, read)) ++passed;
+      }
+    }
+    ASSERT_GT(unshared, 0u);
+    if (direct) EXPECT_EQ(0u, passed) << "hash size " << hash_size;
+    else EXPECT_LT(passed, unshared / 10) << "hash size " << hash_size;
+
+    SR_KmerFilterFree(filter);
+  }
+}
+
+// Hashes with an N are neither loaded nor looked up
+TEST(KmerFilterTest, InvalidBases) {
+  srand(50);
+  const unsigned int hash_size = 10;
+  const string left = MakeSequence(30), right = MakeSequence(30);
+  const string reference = left + "N" + right;
+  SR_KmerFilter* filter = SR_KmerFilterAlloc();
+  SR_KmerFilterLoad(filter, reference.c_str(), reference.size(), hash_size);
+  const set<string> hashes = GetHashes(reference, hash_size);
+
+  // a read across the N of the reference, with a base in its place
+  const string across = left.substr(25) + "A" + right.substr(0, 5);
+  ASSERT_FALSE(SharesHash(hashes, across, hash_size));
+  EXPECT_FALSE(MayContain(filter, across));
+
+  // a piece of the reference with an N in every hash
+  string broken = right.substr(0, 19);
+  broken[9] = 'N';
+  EXPECT_FALSE(MayContain(filter, broken));
+  EXPECT_TRUE(MayContain(filter, right.substr(0, 19)));
+
+  // reads shorter than a hash share nothing
+  EXPECT_FALSE(MayContain(filter, left.substr(0, hash_size - 1)));
+  EXPECT_TRUE(MayContain(filter, left.substr(0, hash_size)));
+
+  // a filter that is not loaded lets everything pass
+  SR_KmerFilterClear(filter);
+  EXPECT_TRUE(MayContain(filter, across));
+  SR_KmerFilterFree(filter);
+}
+} // namespace
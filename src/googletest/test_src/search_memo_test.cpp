@@ -0,0 +1,120 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "utilities/miscellaneous/search_memo.h"
+
+using std::string;
+using Scissors::SearchMemo;
+
+namespace {
+
+SearchMemo::Key MakeKey(const SearchMemo::Search& search, const string& sequence,
+                        const int& begin) {
+  SearchMemo::Key key;
+  key.search              = search;
+  key.sequence_inverse    = false;
+  key.sequence_complement = false;
+  key.ref_id              = search == SearchMemo::kSpecial ? -1 : 1;
+  key.begin               = begin;
+  key.end                 = begin + 400;
+  key.sequence            = sequence;
+  return key;
+}
+
+StripedSmithWaterman::Alignment MakeAlignment(const int& ref_begin) {
+  StripedSmithWaterman::Alignment al;
+  al.Clear();
+  al.sw_score     = 70;
+  al.ref_begin    = ref_begin;
+  al.ref_end      = ref_begin + 69;
+  al.cigar_string = "70M30S";
+  al.cigar.push_back(70 << 4);
+  al.cigar.push_back((30 << 4) | 0x04);
+  return al;
+}
+
+// A result is given back for its key and for no other key
+TEST(SearchMemoTest, HitAndMiss) {
+  SearchMemo memo;
+  const SearchMemo::Key key = MakeKey(SearchMemo::kLocalPartial, "ACGTACGTTTGA", 1000);
+  bool found = false;
+  StripedSmithWaterman::Alignment al;
+  EXPECT_FALSE(memo.Has(key));
+  EXPECT_FALSE(memo.Get(key, &found, &al));
+
+  memo.Put(key, true, MakeAlignment(1200));
+  EXPECT_TRUE(memo.Has(key));
+  ASSERT_TRUE(memo.Get(key, &found, &al));
+  EXPECT_TRUE(found);
+  EXPECT_EQ(1200, al.ref_begin);
+  EXPECT_EQ(1269, al.ref_end);
+  EXPECT_EQ("70M30S", al.cigar_string);
+  EXPECT_EQ(2u, al.cigar.size());
+  EXPECT_EQ(1u, memo.GetHitCount());
+
+  // a search that found nothing is kept as well
+  const SearchMemo::Key missed = MakeKey(SearchMemo::kLocalPartial, "TTTTACGTTTGA", 1000);
+  memo.Put(missed, false, MakeAlignment(0));
+  ASSERT_TRUE(memo.Get(missed, &found, &al));
+  EXPECT_FALSE(found);
+
+  // keys that differ in any field miss
+  SearchMemo::Key other = key;
+  other.sequence[3] = 'A';
+  EXPECT_FALSE(memo.Has(other));
+  other = key;
+  other.search = SearchMemo::kMediumIndel;
+  EXPECT_FALSE(memo.Has(other));
+  other = key;
+  other.sequence_complement = true;
+  EXPECT_FALSE(memo.Has(other));
+  other = key;
+  other.ref_id = 2;
+  EXPECT_FALSE(memo.Has(other));
+  other = key;
+  other.end += 1;
+  EXPECT_FALSE(memo.Has(other));
+  EXPECT_EQ(2u, memo.GetHitCount());
+}
+
+// A new result replaces the result in its slot
+TEST(SearchMemoTest, SlotReplacement) {
+  SearchMemo memo(1);
+  const SearchMemo::Key first  = MakeKey(SearchMemo::kLocalPartial, "ACGTACGTTTGA", 1000);
+  const SearchMemo::Key second = MakeKey(SearchMemo::kLocalPartial, "ACGTACGTTTGA", 3000);
+  memo.Put(first, true, MakeAlignment(1200));
+  memo.Put(second, true, MakeAlignment(3100));
+  EXPECT_FALSE(memo.Has(first));
+
+  bool found = false;
+  StripedSmithWaterman::Alignment al;
+  ASSERT_TRUE(memo.Get(second, &found, &al));
+  EXPECT_EQ(3100, al.ref_begin);
+
+  // the same key takes the new result
+  memo.Put(second, false, MakeAlignment(0));
+  ASSERT_TRUE(memo.Get(second, &found, &al));
+  EXPECT_FALSE(found);
+}
+
+// ClearNormal keeps the results of the special searches only
+TEST(SearchMemoTest, Clear) {
+  SearchMemo memo;
+  const SearchMemo::Key local   = MakeKey(SearchMemo::kLocalPartial, "ACGTACGTTTGA", 1000);
+  const SearchMemo::Key indel   = MakeKey(SearchMemo::kMediumIndel, "ACGTACGTTTGA", 1000);
+  const SearchMemo::Key special = MakeKey(SearchMemo::kSpecial, "ACGTACGTTTGA", 0);
+  memo.Put(local, true, MakeAlignment(1200));
+  memo.Put(indel, true, MakeAlignment(1200));
+  memo.Put(special, true, MakeAlignment(20));
+  ASSERT_TRUE(memo.Has(local) && memo.Has(indel) && memo.Has(special));
+
+  memo.ClearNormal();
+  EXPECT_FALSE(memo.Has(local));
+  EXPECT_FALSE(memo.Has(indel));
+  EXPECT_TRUE(memo.Has(special));
+
+  memo.Clear();
+  EXPECT_FALSE(memo.Has(special));
+}
+} // namespace
@@ -0,0 +1,172 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "utilities/miscellaneous/split_indel_aligner.h"
+
+using std::string;
+using std::vector;
+using Scissors::SplitIndelAligner;
+
+namespace {
+// The scores of the medium-sized indel aligner
+const int kMatch          = 30;
+const int kMismatch       = 60;
+const int kGapOpen        = 60;
+const int kGapExtend      = 1;
+const int kMinPieceLength = 7;
+
+// A random reference; the bases are translated as SSW translates them
+void MakeReference(const int& length, vector<int8_t>* ref) {
+  srand(6060);
+  ref->resize(length);
+  for (int i = 0; i < length; ++i) (*ref)[i] = rand() % 4;
+}
+
+// Appends ref[begin, end) to read
+void Append(const vector<int8_t>& ref, const int& begin, const int& end, vector<int8_t>* read) {
+  read->insert(read->end(), ref.begin() + begin, ref.begin() + end);
+}
+
+bool Align(const vector<int8_t>& read, const vector<int8_t>& ref,
+           StripedSmithWaterman::Alignment* al) {
+  SplitIndelAligner aligner;
+  return aligner.Align(&read[0], read.size(), &ref[0], ref.size(), kMatch, kMismatch,
+                       kGapOpen, kGapExtend, kMinPieceLength, al);
+}
+} // namespace
+
+// ref[100, 120) is deleted from the read
+TEST(SplitIndelAligner, Deletion) {
+  vector<int8_t> ref;
+  MakeReference(200, &ref);
+  // the bases at both ends of the deletion differ from the ones after it,
+  //  so the breakpoint cannot shift
+  ref[100] = (ref[120] + 1) % 4;
+  ref[119] = (ref[99] + 1) % 4;
+  vector<int8_t> read;
+  Append(ref, 50, 100, &read);
+  Append(ref, 120, 170, &read);
+
+  StripedSmithWaterman::Alignment al;
+  ASSERT_TRUE(Align(read, ref, &al));
+  EXPECT_EQ("50M20D50M", al.cigar_string);
+  ASSERT_EQ(3U, al.cigar.size());
+  EXPECT_EQ(static_cast<uint32_t>(50 << 4), al.cigar[0]);
+  EXPECT_EQ(static_cast<uint32_t>((20 << 4) | 0x02), al.cigar[1]);
+  EXPECT_EQ(static_cast<uint32_t>(50 << 4), al.cigar[2]);
+  EXPECT_EQ(100 * kMatch - kGapOpen - 19 * kGapExtend, al.sw_score);
+  EXPECT_EQ(0, al.query_begin);
+  EXPECT_EQ(99, al.query_end);
+  EXPECT_EQ(50, al.ref_begin);
+  EXPECT_EQ(169, al.ref_end);
+  // the deleted bases count as mismatches
+  EXPECT_EQ(20, al.mismatches);
+}
+
+// Ten bases are inserted into the read after ref[99]
+TEST(SplitIndelAligner, Insertion) {
+  vector<int8_t> ref;
+  MakeReference(200, &ref);
+  vector<int8_t> inserted(10);
+  for (int i = 0; i < 10; ++i) inserted[i] = i % 4;
+  // the inserted bases at both ends differ from the reference next to them
+  inserted[0] = (ref[100] + 1) % 4;
+  inserted[9] = (ref[99] + 1) % 4;
+  vector<int8_t> read;
+  Append(ref, 50, 100, &read);
+  read.insert(read.end(), inserted.begin(), inserted.end());
+  Append(ref, 100, 150, &read);
+
+  StripedSmithWaterman::Alignment al;
+  ASSERT_TRUE(Align(read, ref, &al));
+  EXPECT_EQ("50M10I50M", al.cigar_string);
+  ASSERT_EQ(3U, al.cigar.size());
+  EXPECT_EQ(static_cast<uint32_t>((10 << 4) | 0x01), al.cigar[1]);
+  EXPECT_EQ(100 * kMatch - kGapOpen - 9 * kGapExtend, al.sw_score);
+  EXPECT_EQ(0, al.query_begin);
+  EXPECT_EQ(109, al.query_end);
+  EXPECT_EQ(50, al.ref_begin);
+  EXPECT_EQ(149, al.ref_end);
+  EXPECT_EQ(10, al.mismatches);
+}
+
+// Read bases that match no reference base around the pieces are clipped
+TEST(SplitIndelAligner, Clips) {
+  vector<int8_t> ref;
+  MakeReference(200, &ref);
+  ref[100] = (ref[120] + 1) % 4;
+  ref[119] = (ref[99] + 1) % 4;
+  vector<int8_t> read;
+  for (int i = 40; i < 50; ++i) read.push_back((ref[i] + 1) % 4);
+  Append(ref, 50, 100, &read);
+  Append(ref, 120, 160, &read);
+  for (int i = 160; i < 165; ++i) read.push_back((ref[i] + 2) % 4);
+
+  StripedSmithWaterman::Alignment al;
+  ASSERT_TRUE(Align(read, ref, &al));
+  EXPECT_EQ("10S50M20D40M5S", al.cigar_string);
+  EXPECT_EQ(10, al.query_begin);
+  EXPECT_EQ(99, al.query_end);
+  EXPECT_EQ(50, al.ref_begin);
+  EXPECT_EQ(159, al.ref_end);
+}
+
+// A read without a gap is a single piece, which no join beats
+TEST(SplitIndelAligner, NoGap) {
+  vector<int8_t> ref;
+  MakeReference(200, &ref);
+  vector<int8_t> read;
+  Append(ref, 50, 150, &read);
+
+  StripedSmithWaterman::Alignment al;
+  EXPECT_FALSE(Align(read, ref, &al));
+  EXPECT_TRUE(al.cigar.empty());
+  EXPECT_TRUE(al.cigar_string.empty());
+}
+
+// A join whose piece is shorter than min_piece_length is rejected
+TEST(SplitIndelAligner, ShortPiece) {
+  vector<int8_t> ref;
+  MakeReference(200, &ref);
+  ref[100] = (ref[120] + 1) % 4;
+  ref[119] = (ref[99] + 1) % 4;
+  vector<int8_t> read;
+  Append(ref, 95, 100, &read);
+  Append(ref, 120, 195, &read);
+
+  StripedSmithWaterman::Alignment al;
+  EXPECT_FALSE(Align(read, ref, &al));
+  EXPECT_TRUE(al.cigar.empty());
+
+  // but passes a lower bound
+  SplitIndelAligner aligner;
+  ASSERT_TRUE(aligner.Align(&read[0], read.size(), &ref[0], ref.size(), kMatch, kMismatch,
+                            kGapOpen, kGapExtend, 5, &al));
+  EXPECT_EQ("5M20D75M", al.cigar_string);
+}
+
+// The matrices kept from a longer read do not change the next alignment
+TEST(SplitIndelAligner, Reuse) {
+  vector<int8_t> ref;
+  MakeReference(200, &ref);
+  ref[100] = (ref[120] + 1) % 4;
+  ref[119] = (ref[99] + 1) % 4;
+  vector<int8_t> long_read, read;
+  Append(ref, 0, 150, &long_read);
+  Append(ref, 80, 100, &read);
+  Append(ref, 120, 140, &read);
+
+  SplitIndelAligner aligner;
+  StripedSmithWaterman::Alignment al;
+  EXPECT_FALSE(aligner.Align(&long_read[0], long_read.size(), &ref[0], ref.size(), kMatch,
+                             kMismatch, kGapOpen, kGapExtend, kMinPieceLength, &al));
+  ASSERT_TRUE(aligner.Align(&read[0], read.size(), &ref[0], ref.size(), kMatch, kMismatch,
+                            kGapOpen, kGapExtend, kMinPieceLength, &al));
+  EXPECT_EQ("20M20D20M", al.cigar_string);
+  EXPECT_EQ(80, al.ref_begin);
+}
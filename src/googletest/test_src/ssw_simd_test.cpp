@@ -0,0 +1,207 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "utilities/smithwaterman/ssw.h"
+}
+
+using std::string;
+using std::vector;
+
+namespace {
+
+// Builds the 5x5 (ACGTN) matrix that ssw_cpp uses
+void BuildMatrix(const int8_t& match, const int8_t& mismatch, vector<int8_t>* matrix) {
+  matrix->assign(25, 0);
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j)
+      (*matrix)[i * 5 + j] = (i == j) ? match : -mismatch;
+}
+
+// Copies the reference window into the read with mismatches and indels
+void MutateRead(const vector<int8_t>& reference, const int& begin, const int& length,
+                vector<int8_t>* read) {
+  read->clear();
+  for (int i = begin; i < begin + length && i < static_cast<int>(reference.size()); ++i) {
+    const int dice = rand() % 100;
+    if (dice < 4) {
+      read->push_back((reference[i] + 1 + rand() % 3) % 4);  // mismatch
+    } else if (dice < 6) {
+      const int inserted = 1 + rand() % 6;
+      for (int j = 0; j < inserted; ++j) read->push_back(rand() % 4);
+      read->push_back(reference[i]);
+    } else if (dice < 8) {
+      i += rand() % 6;  // deletion
+    } else {
+      read->push_back(reference[i]);
+    }
+  }
+  if (read->empty()) read->push_back(rand() % 4);
+}
+
+void ExpectSameAlignment(const s_align& expect, const s_align& actual) {
+  EXPECT_EQ(expect.score1, actual.score1);
+  EXPECT_EQ(expect.score2, actual.score2);
+  EXPECT_EQ(expect.ref_begin1, actual.ref_begin1);
+  EXPECT_EQ(expect.ref_end1, actual.ref_end1);
+  EXPECT_EQ(expect.read_begin1, actual.read_begin1);
+  EXPECT_EQ(expect.read_end1, actual.read_end1);
+  EXPECT_EQ(expect.ref_end2, actual.ref_end2);
+  ASSERT_EQ(expect.cigarLen, actual.cigarLen);
+  for (int i = 0; i < expect.cigarLen; ++i)
+    EXPECT_EQ(expect.cigar[i], actual.cigar[i]);
+}
+
+// Aligns random reads by SSE2 and by every wider kernel the CPU has
+void TestKernels(const int8_t& match, const int8_t& mismatch,
+                 const uint8_t& gap_open, const uint8_t& gap_extend) {
+  const ssw_simd supported = ssw_simd_supported();
+  vector<int8_t> matrix;
+  BuildMatrix(match, mismatch, &matrix);
+
+  srand(1010);
+  for (int round = 0; round < 300; ++round) {
+    vector<int8_t> reference(50 + rand() % 1500);
+    for (unsigned int i = 0; i < reference.size(); ++i) reference[i] = rand() % 4;
+
+    const int begin  = rand() % reference.size();
+    const int length = 1 + rand() % 300;
+    vector<int8_t> read;
+    MutateRead(reference, begin, length, &read);
+
+    const int32_t mask_len = read.size() / 2 < 15 ? 15 : read.size() / 2;
+
+    ssw_set_simd(SSW_SIMD_SSE2);
+    s_profile* profile = ssw_init(&read[0], read.size(), &matrix[0], 5, 2);
+    s_align* expect = ssw_align(profile, &reference[0], reference.size(),
+                                gap_open, gap_extend, 1, 0, 0, mask_len);
+    init_destroy(profile);
+    ASSERT_TRUE(expect != NULL);
+
+    for (int simd = SSW_SIMD_AVX2; simd <= supported; ++simd) {
+      EXPECT_EQ(simd, ssw_set_simd(static_cast<ssw_simd>(simd)));
+      profile = ssw_init(&read[0], read.size(), &matrix[0], 5, 2);
+      s_align* actual = ssw_align(profile, &reference[0], reference.size(),
+                                  gap_open, gap_extend, 1, 0, 0, mask_len);
+      init_destroy(profile);
+      ASSERT_TRUE(actual != NULL);
+      ExpectSameAlignment(*expect, *actual);
+      align_destroy(actual);
+    }
+    align_destroy(expect);
+  }
+
+  ssw_set_simd(supported);
+}
+
+// Prints how many DP cells per second ssw_init and ssw_align go through with
+//  each kernel level, for reads of read_length against windows of window_length
+void TimeKernels(const int& read_length, const int& window_length, const uint8_t& flag) {
+  const ssw_simd supported = ssw_simd_supported();
+  vector<int8_t> matrix;
+  BuildMatrix(2, 2, &matrix);
+
+  srand(4040);
+  const int count = 1000;
+  vector<vector<int8_t> > references(count), reads(count);
+  double cells = 0;
+  for (int i = 0; i < count; ++i) {
+    references[i].resize(window_length);
+    for (int j = 0; j < window_length; ++j) references[i][j] = rand() % 4;
+    MutateRead(references[i], rand() % (window_length - read_length), read_length, &reads[i]);
+    cells += static_cast<double>(reads[i].size()) * window_length;
+  }
+
+  const char* names[] = {"SSE2", "AVX2", "AVX-512BW"};
+  const int repeats = 5;
+  double sse2_rate = 0;
+  for (int simd = SSW_SIMD_SSE2; simd <= supported; ++simd) {
+    ssw_set_simd(static_cast<ssw_simd>(simd));
+    const clock_t begin = clock();
+    for (int r = 0; r < repeats; ++r) {
+      for (int i = 0; i < count; ++i) {
+        const int32_t mask_len = reads[i].size() / 2 < 15 ? 15 : reads[i].size() / 2;
+        s_profile* profile = ssw_init(&reads[i][0], reads[i].size(), &matrix[0], 5, 2);
+        s_align* al = ssw_align(profile, &references[i][0], window_length,
+                                3, 1, flag, 0, 0, mask_len);
+        align_destroy(al);
+        init_destroy(profile);
+      }
+    }
+    const double seconds = static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+    const double rate = cells * repeats / seconds / 1e9;
+    if (simd == SSW_SIMD_SSE2) sse2_rate = rate;
+    printf("%d bp reads, %d bp windows, flag 0x%02x, %-9s %6.2f GCUPS (%.2fx SSE2)\n",
+           read_length, window_length, flag, names[simd], rate, rate / sse2_rate);
+  }
+
+  ssw_set_simd(supported);
+}
+} // namespace
+
+// Alignments that fail the score filter of bit 4 and 7 get no beginning
+//  position, and the ones that pass it are aligned as usual
+TEST(SswSimdTest, ScoreFilterSkipsBeginPosition) {
+  vector<int8_t> matrix;
+  BuildMatrix(1, 3, &matrix);
+
+  srand(3030);
+  for (int round = 0; round < 100; ++round) {
+    vector<int8_t> reference(50 + rand() % 500);
+    for (unsigned int i = 0; i < reference.size(); ++i) reference[i] = rand() % 4;
+    vector<int8_t> read;
+    MutateRead(reference, rand() % reference.size(), 1 + rand() % 150, &read);
+    const int32_t mask_len = read.size() / 2 < 15 ? 15 : read.size() / 2;
+    const uint16_t filter = rand() % 60;
+
+    s_profile* profile = ssw_init(&read[0], read.size(), &matrix[0], 5, 2);
+    s_align* expect = ssw_align(profile, &reference[0], reference.size(),
+                                5, 2, 0x0f, 0, 32767, mask_len);
+    s_align* actual = ssw_align(profile, &reference[0], reference.size(),
+                                5, 2, 0x1f, filter, 32767, mask_len);
+    init_destroy(profile);
+    ASSERT_TRUE(expect != NULL);
+    ASSERT_TRUE(actual != NULL);
+
+    if (expect->score1 >= filter) {
+      ExpectSameAlignment(*expect, *actual);
+    } else {
+      EXPECT_EQ(expect->score1, actual->score1);
+      EXPECT_EQ(expect->ref_end1, actual->ref_end1);
+      EXPECT_EQ(expect->read_end1, actual->read_end1);
+      EXPECT_EQ(-1, actual->ref_begin1);
+      EXPECT_EQ(-1, actual->read_begin1);
+      EXPECT_EQ(0, actual->cigarLen);
+    }
+    align_destroy(expect);
+    align_destroy(actual);
+  }
+}
+
+// The scores of (1,3,5,2) stay in the 8-bit kernels
+TEST(SswSimdTest, ByteKernels) {
+  TestKernels(1, 3, 5, 2);
+}
+
+// The scores of (30,60,60,1) overflow 8 bits and go to the 16-bit kernels
+TEST(SswSimdTest, WordKernels) {
+  TestKernels(30, 60, 60, 1);
+}
+
+// Not a check: the speed of the kernel levels on short and long reads, which
+//  sets the read lengths where ssw_init widens its kernels. Run it with
+//  --gtest_also_run_disabled_tests
+TEST(SswSimdTest, DISABLED_Throughput) {
+  const int read_lengths[] = {100, 150, 250, 500, 1000};
+  for (unsigned int i = 0; i < sizeof(read_lengths) / sizeof(read_lengths[0]); ++i) {
+    TimeKernels(read_lengths[i], 3000, 0);
+    TimeKernels(read_lengths[i], 3000, 0x0f);
+  }
+}
@@ -0,0 +1,187 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "utilities/miscellaneous/ungapped_extension.h"
+
+using std::string;
+using std::vector;
+namespace UngappedExtension = Scissors::UngappedExtension;
+
+namespace {
+const int kMatch    = 2;
+const int kMismatch = 2;
+
+void Translate(const string& bases, vector<int8_t>* codes) {
+  const string alphabet = "ACGT";
+  codes->clear();
+  for (unsigned int i = 0; i < bases.size(); ++i) {
+    const size_t code = alphabet.find(bases[i]);
+    codes->push_back(code == string::npos ? 4 : code);
+  }
+}
+
+// Extends the seed at seed_begin of read against ref, which faces it base by
+//  base, and sets al to the best extension placed at ref_begin
+int Extend(const string& read_bases, const string& ref_bases, const int& seed_begin,
+           const int& xdrop, const int& ref_begin, StripedSmithWaterman::Alignment* al) {
+  vector<int8_t> read, ref;
+  Translate(read_bases, &read);
+  Translate(ref_bases, &ref);
+  int query_begin = 0, query_end = 0;
+  const int score = UngappedExtension::Extend(&read[0], &ref[0], 0, read.size() - 1,
+      seed_begin, kMatch, kMismatch, xdrop, &query_begin, &query_end);
+  UngappedExtension::SetAlignment(&read[0], &ref[0], read.size(), score,
+      query_begin, query_end, ref_begin, al);
+  return score;
+}
+} // namespace
+
+// A read that matches its diagonal is aligned from end to end
+TEST(UngappedExtension, FullMatch) {
+  const string ref = "ACGTTGCAACGTAGCTAGCTAGGATCCATG";
+  StripedSmithWaterman::Alignment al;
+  EXPECT_EQ(30 * kMatch, Extend(ref, ref, 10, 5, 100, &al));
+  EXPECT_EQ("30M", al.cigar_string);
+  EXPECT_EQ(0, al.query_begin);
+  EXPECT_EQ(29, al.query_end);
+  EXPECT_EQ(100, al.ref_begin);
+  EXPECT_EQ(129, al.ref_end);
+  EXPECT_EQ(0, al.mismatches);
+}
+
+// The extension stops once the score drops more than xdrop below the best
+//  one, and the bases past the best score are clipped
+TEST(UngappedExtension, XdropStopsAndClips) {
+  const string ref  = "ACGTTGCAACGTAGCTAGCTAGGATCCATG";
+  // read bases 19-21 mismatch, the 8 after them match
+  const string read = "ACGTTGCAACGTAGCTAGCGCTGATCCATG";
+  StripedSmithWaterman::Alignment al;
+  // 3 mismatches cost 6: more than an X-drop of 5
+  EXPECT_EQ(19 * kMatch, Extend(read, ref, 0, 5, 0, &al));
+  EXPECT_EQ("19M11S", al.cigar_string);
+  EXPECT_EQ(18, al.query_end);
+  EXPECT_EQ(18, al.ref_end);
+  EXPECT_EQ(0, al.mismatches);
+
+  // An X-drop of 10 goes through them, and the matches after them win
+  //  back what they cost
+  EXPECT_EQ(27 * kMatch - 3 * kMismatch, Extend(read, ref, 0, 10, 0, &al));
+  EXPECT_EQ("30M", al.cigar_string);
+  EXPECT_EQ(29, al.ref_end);
+  EXPECT_EQ(3, al.mismatches);
+
+  // but not the ones of a longer run, which stays clipped
+  const string worse = "ACGTTGCAACGTAGCTAGCGCTCTCCCATG";
+  EXPECT_EQ(19 * kMatch, Extend(worse, ref, 0, 10, 0, &al));
+  EXPECT_EQ("19M11S", al.cigar_string);
+}
+
+// A mismatch that the later matches pay for is kept within the X-drop
+TEST(UngappedExtension, XdropKeepsRecoveredMismatch) {
+  const string ref  = "ACGTTGCAACGTAGCTAGCTAGGATCCATG";
+  const string read = "ACGTTGCAACGTAGCTAGCTTGGATCCATG";
+  StripedSmithWaterman::Alignment al;
+  EXPECT_EQ(29 * kMatch - kMismatch, Extend(read, ref, 0, 5, 0, &al));
+  EXPECT_EQ("30M", al.cigar_string);
+  EXPECT_EQ(1, al.mismatches);
+
+  // Without any X-drop the extension stops at the mismatch
+  EXPECT_EQ(20 * kMatch, Extend(read, ref, 0, 0, 0, &al));
+  EXPECT_EQ("20M10S", al.cigar_string);
+}
+
+// The extension goes left from the base before the seed, and the read
+//  before its best score is clipped
+TEST(UngappedExtension, LeftClip) {
+  const string ref  = "ACGTTGCAACGTAGCTAGCTAGGATCCATG";
+  const string read = "TGCATGCAACGTAGCTAGCTAGGATCCATG";
+  StripedSmithWaterman::Alignment al;
+  EXPECT_EQ(26 * kMatch, Extend(read, ref, 20, 5, 50, &al));
+  EXPECT_EQ("4S26M", al.cigar_string);
+  EXPECT_EQ(4, al.query_begin);
+  EXPECT_EQ(54, al.ref_begin);
+  EXPECT_EQ(79, al.ref_end);
+}
+
+// The extension stays in [low, high], and N scores nothing
+TEST(UngappedExtension, BoundsAndN) {
+  const string ref  = "ACGTTGCAACGTAGCTAGCTAGGATCCATG";
+  const string read = "ACGTTGCAACGTNGCTAGCTAGGATCCATG";
+  vector<int8_t> read_codes, ref_codes;
+  Translate(read, &read_codes);
+  Translate(ref, &ref_codes);
+  int query_begin = 0, query_end = 0;
+  EXPECT_EQ(15 * kMatch, UngappedExtension::Extend(&read_codes[0], &ref_codes[0], 5, 20,
+      10, kMatch, kMismatch, 5, &query_begin, &query_end));
+  EXPECT_EQ(5, query_begin);
+  EXPECT_EQ(20, query_end);
+
+  StripedSmithWaterman::Alignment al;
+  UngappedExtension::SetAlignment(&read_codes[0], &ref_codes[0], read.size(), 15 * kMatch,
+      query_begin, query_end, 0, &al);
+  EXPECT_EQ("5S16M9S", al.cigar_string);
+  // N differs from the reference base
+  EXPECT_EQ(1, al.mismatches);
+}
+
+// A seed whose bases all mismatch gives nothing
+TEST(UngappedExtension, NoScore) {
+  vector<int8_t> read, ref;
+  Translate("AAAAAAAAAA", &read);
+  Translate("CCCCCCCCCC", &ref);
+  int query_begin = 0, query_end = 0;
+  EXPECT_EQ(0, UngappedExtension::Extend(&read[0], &ref[0], 0, 9, 5, kMatch, kMismatch, 5,
+                                         &query_begin, &query_end));
+  EXPECT_EQ(5, query_begin);
+  EXPECT_EQ(4, query_end);
+}
+
+// Not a check: the time of extending a seed against the time of SSW over a
+//  local window, for 100 bp reads in 600 bp windows. Run it with
+//  --gtest_also_run_disabled_tests
+TEST(UngappedExtension, DISABLED_Throughput) {
+  const int count = 10000, read_length = 100, window_length = 600;
+  const string alphabet = "ACGT";
+  srand(5050);
+  vector<string> windows(count), reads(count);
+  vector<int> positions(count);
+  for (int i = 0; i < count; ++i) {
+    for (int j = 0; j < window_length; ++j) windows[i] += alphabet[rand() % 4];
+    positions[i] = rand() % (window_length - read_length);
+    reads[i] = windows[i].substr(positions[i], read_length);
+    for (int k = 0; k < 2; ++k) reads[i][rand() % read_length] = alphabet[rand() % 4];
+  }
+
+  StripedSmithWaterman::Aligner aligner;
+  StripedSmithWaterman::Filter filter;
+  StripedSmithWaterman::Alignment al;
+  clock_t begin = clock();
+  for (int i = 0; i < count; ++i)
+    aligner.Align(reads[i].c_str(), windows[i].c_str(), window_length, filter, &al);
+  const double ssw_seconds = static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+  vector<int8_t> read, window;
+  begin = clock();
+  for (int i = 0; i < count; ++i) {
+    // the seed is given; the window is translated as the window cache keeps it
+    Translate(reads[i], &read);
+    Translate(windows[i], &window);
+    int query_begin = 0, query_end = 0;
+    const int score = UngappedExtension::Extend(&read[0], &window[positions[i]], 0,
+        read_length - 1, read_length / 2, kMatch, kMismatch, 10, &query_begin, &query_end);
+    UngappedExtension::SetAlignment(&read[0], &window[positions[i]], read_length, score,
+        query_begin, query_end, positions[i], &al);
+  }
+  const double extension_seconds = static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+  printf("SSW %.2f us, ungapped extension %.2f us a read (%.1fx)\n",
+         ssw_seconds * 1e6 / count, extension_seconds * 1e6 / count,
+         ssw_seconds / extension_seconds);
+}
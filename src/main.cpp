@@ -11,6 +11,7 @@ extern "C" {
 #include "utilities/miscellaneous/md5.h"
 }
 
+#include "dataStructures/hash_setting.h"
 #include "dataStructures/target_event.h"
 #include "dataStructures/target_region.h"
 #include "outsources/fasta/Fasta.h"
@@ -41,6 +42,7 @@ struct MainVars{
   AlignmentFilter  alignment_filter;
   TargetEvent      target_event;
   TargetRegion     target_region;
+  HashSetting      hash_setting;
 };
 
 
@@ -63,6 +65,8 @@ void SetTargetEvent(const Parameters& parameters,
                     TargetEvent* target_event);
 void SetTargetRegion(const Parameters& parameters,
                      TargetRegion* target_region);
+void SetHashSetting(const Parameters& parameters,
+                    HashSetting* hash_setting);
 
 
 int main (int argc, char** argv) {
@@ -124,6 +128,7 @@ int main (int argc, char** argv) {
 		parameters.mapping_quality_threshold,
 		vars.alignment_filter,
 		vars.target_region,
+		vars.hash_setting,
 		parameters.input_special_fasta,
 		&files.ref_reader,
 		files.bam_reader,
@@ -216,6 +221,11 @@ void InitVariablesOrDie(const Parameters& parameters,
   vars->bam_header = SR_BamHeaderAlloc();
   vars->bam_header = SR_BamInStreamLoadHeader(files->bam_reader);
 
+  SetAlignmentFilter(parameters, &(vars->alignment_filter));
+  SetTargetEvent(parameters, &(vars->target_event));
+  SetTargetRegion(parameters, &(vars->target_region));
+  SetHashSetting(parameters, &(vars->hash_setting));
+
   // Jump the bam if region is given
   if (!parameters.region.empty()) {
     int tid = 0, begin = 0, end = 0;
@@ -224,14 +234,14 @@ void InitVariablesOrDie(const Parameters& parameters,
       exit(1); // parsing the specified region fails.
     }
     SR_BamInStreamJump(files->bam_reader, tid, begin, end);
+    // only the region (plus padding) of the chromosome will be loaded
+    vars->target_region.region_id    = tid;
+    vars->target_region.region_begin = begin;
+    vars->target_region.region_end   = end;
   }
 
   IsInputBamSortedOrDie(parameters, *(vars->bam_header));
 
-  SetAlignmentFilter(parameters, &(vars->alignment_filter));
-  SetTargetEvent(parameters, &(vars->target_event));
-  SetTargetRegion(parameters, &(vars->target_region));
-
   // print bam header
 #ifdef VERBOSE_DEBUG
   cerr << "=== The original references in the bam header ===" << endl;
@@ -393,4 +403,18 @@ void SetTargetRegion(const Parameters& parameters,
   target_region->fragment_length       = parameters.fragment_length;
   target_region->local_window_size     = parameters.mate_window_size;
   target_region->discovery_window_size = parameters.discovery_window_size;
+  target_region->local_seed_band       = parameters.local_seed_band;
+  target_region->ungapped_xdrop        = parameters.ungapped_xdrop;
+  target_region->split_indel_dp        = parameters.split_indel_dp;
+  target_region->junction_cache        = parameters.junction_cache;
+  target_region->decisive_indel_rate   = parameters.decisive_indel_rate;
+  target_region->decisive_local_rate   = parameters.decisive_local_rate;
+}
+
+void SetHashSetting(const Parameters& parameters,
+                    HashSetting* hash_setting) {
+  hash_setting->minimizer_window  = parameters.minimizer_window;
+  hash_setting->hash_size         = parameters.hash_size;
+  hash_setting->special_hash_size = parameters.special_hash_size;
+  hash_setting->max_occurrence    = parameters.max_hash_occurrence;
 }
@@ -218,10 +218,12 @@ FastaIndexEntry FastaIndex::entry(string name) {
 
 string FastaIndex::indexFileExtension() { return ".fai"; }
 
-/*
-FastaReference::FastaReference(string reffilename) {
-}
-*/
+FastaReference::FastaReference(void)
+    : file(NULL)
+    , index(NULL)
+    , mapping(NULL)
+    , mappingSize(0)
+{}
 
 void FastaReference::open(string reffilename) {
     filename = reffilename;
@@ -240,31 +242,75 @@ void FastaReference::open(string reffilename) {
         index->indexReference(filename);
         index->writeIndexFile(indexFileName);
     }
+    // map the file so that sequences are copied straight out of the page cache;
+    // on failure we silently fall back to fseek/fread
+    struct stat fileInfo;
+    if (fstat(fileno(file), &fileInfo) == 0 && fileInfo.st_size > 0) {
+        void* m = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+        if (m != MAP_FAILED) {
+            mapping = (char*) m;
+            mappingSize = fileInfo.st_size;
+        }
+    }
 }
 
 FastaReference::~FastaReference(void) {
-    fclose(file);
+    if (mapping != NULL)
+        munmap(mapping, mappingSize);
+    if (file != NULL)
+        fclose(file);
     delete index;
 }
 
+void FastaReference::copyBases(const FastaIndexEntry& entry, long long start, int length, char* dest) {
+    if (length <= 0) return;
+    const long long firstLine = start / entry.line_blen;
+    const long long lastLine  = (start + length - 1) / entry.line_blen;
+    const long long rawBegin  = entry.offset + firstLine * entry.line_len + start % entry.line_blen;
+    const long long rawEnd    = entry.offset + lastLine * entry.line_len
+                              + (start + length - 1) % entry.line_blen + 1;
+
+    const char* raw;
+    if (mapping != NULL && rawEnd <= (long long) mappingSize) {
+        raw = mapping + rawBegin;
+    } else {
+        readBuffer.resize(rawEnd - rawBegin);
+        fseek64(file, (off_type) rawBegin, SEEK_SET);
+        size_t got = fread(&readBuffer[0], sizeof(char), readBuffer.size(), file);
+        if (got != readBuffer.size()) {
+            cerr << "Error: unexpected end of file while reading " << entry.name << endl;
+            exit(1);
+        }
+        raw = &readBuffer[0];
+    }
+
+    // one pass: copy each line's bases and jump over its terminator
+    int column = start % entry.line_blen;
+    const int terminator = entry.line_len - entry.line_blen;
+    while (length > 0) {
+        int n = entry.line_blen - column;
+        if (n > length) n = length;
+        memcpy(dest, raw, n);
+        dest   += n;
+        raw    += n + terminator;
+        length -= n;
+        column  = 0;
+    }
+}
+
 string FastaReference::getSequence(string seqname) {
-    FastaIndexEntry entry = index->entry(seqname);
-    int newlines_in_sequence = entry.length / entry.line_blen;
-    int seqlen = newlines_in_sequence  + entry.length;
-    char* seq = (char*) calloc (seqlen + 1, sizeof(char));
-    fseek64(file, entry.offset, SEEK_SET);
-    fread(seq, sizeof(char), seqlen, file);
-    seq[seqlen] = '\0';
-    char* pbegin = seq;
-    char* pend = seq + (seqlen/sizeof(char));
-    pend = remove(pbegin, pend, '\n');
-    pend = remove(pbegin, pend, '\0');
-    string s = seq;
-    free(seq);
-    s.resize((pend - pbegin)/sizeof(char));
+    string s;
+    getSequence(seqname, s);
     return s;
 }
 
+void FastaReference::getSequence(string seqname, string& sequence) {
+    FastaIndexEntry entry = index->entry(seqname);
+    sequence.resize(entry.length);
+    if (entry.length > 0)
+        copyBases(entry, 0, entry.length, &sequence[0]);
+}
+
 // TODO cleanup; odd function.  use a map
 string FastaReference::sequenceNameStartingWith(string seqnameStart) {
     try {
@@ -276,32 +322,26 @@ string FastaReference::sequenceNameStartingWith(string seqnameStart) {
 }
 
 string FastaReference::getSubSequence(string seqname, int start, int length) {
+    string s;
+    getSubSequence(seqname, start, length, s);
+    return s;
+}
+
+void FastaReference::getSubSequence(string seqname, int start, int length, string& sequence) {
     FastaIndexEntry entry = index->entry(seqname);
     if (start < 0 || length < 1) {
         cerr << "Error: cannot construct subsequence with negative offset or length < 1"
            << "(attempting start = " << start << " and length = " << length << ")" << endl;
         exit(1);
     }
-    // we have to handle newlines
-    // approach: count newlines before start
-    //           count newlines by end of read
-    //             subtracting newlines before start find count of embedded newlines
-    int newlines_before = start > 0 ? (start - 1) / entry.line_blen : 0;
-    int newlines_by_end = (start + length - 1) / entry.line_blen;
-    int newlines_inside = newlines_by_end - newlines_before;
-    int seqlen = length + newlines_inside;
-    char* seq = (char*) calloc (seqlen + 1, sizeof(char));
-    fseek64(file, (off_t) (entry.offset + newlines_before + start), SEEK_SET);
-    fread(seq, sizeof(char), (off_t) seqlen, file);
-    seq[seqlen] = '\0';
-    char* pbegin = seq;
-    char* pend = seq + (seqlen/sizeof(char));
-    pend = remove(pbegin, pend, '\n');
-    pend = remove(pbegin, pend, '\0');
-    string s = seq;
-    free(seq);
-    s.resize((pend - pbegin)/sizeof(char));
-    return s;
+    // clip to the end of the sequence
+    if (start >= entry.length)
+        length = 0;
+    else if (length > entry.length - start)
+        length = entry.length - start;
+    sequence.resize(length);
+    if (length > 0)
+        copyBases(entry, start, length, &sequence[0]);
 }
 
 long unsigned int FastaReference::sequenceLength(string seqname) {
@@ -18,9 +18,11 @@
 #include <algorithm>
 #include "LargeFileSupport.h"
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include "split.h"
 #include <stdlib.h>
 #include <ctype.h>
+#include <string.h>
 #include <unistd.h>
 
 using namespace std;
@@ -56,18 +58,29 @@ class FastaIndex : public map<string, FastaIndexEntry> {
 
 class FastaReference {
     public:
+        FastaReference(void);
         void open(string reffilename);
         string filename;
         ~FastaReference(void);
         FILE* file;
         FastaIndex* index;
+        // read-only mapping of the whole fasta file; NULL if mmap is unavailable,
+        // in which case sequences are read through file instead
+        char* mapping;
+        off_type mappingSize;
         vector<FastaIndexEntry> findSequencesStartingWith(string seqnameStart);
         string getSequence(string seqname);
-        // potentially useful for performance, investigate
-        // void getSequence(string seqname, string& sequence);
+        // fills sequence in place, reusing its capacity across calls
+        void getSequence(string seqname, string& sequence);
         string getSubSequence(string seqname, int start, int length);
+        void getSubSequence(string seqname, int start, int length, string& sequence);
         string sequenceNameStartingWith(string seqnameStart);
         long unsigned int sequenceLength(string seqname);
+    private:
+        // copies length bases starting at base start of entry into dest,
+        // skipping line terminators using line_blen and line_len
+        void copyBases(const FastaIndexEntry& entry, long long start, int length, char* dest);
+        vector<char> readBuffer;  // raw bytes when the file is not mapped
 };
 
 #endif
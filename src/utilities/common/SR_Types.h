@@ -99,8 +99,12 @@ typedef SR_SeqAction SR_Strand;
 
 #define MD5_STR_LEN 32
 
+// the largest hash size of a hash table with a dense index array
 #define MAX_HASH_SIZE 12
 
+// the largest hash size of a hash table with a sorted key directory
+#define MAX_LONG_HASH_SIZE 31
+
 #define SR_EMPTY 0
 
 #define NUM_TOTAL_PAIR_MODE 8
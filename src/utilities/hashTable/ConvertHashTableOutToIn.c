@@ -5,6 +5,7 @@
 
 void ConvertHashTableOutToIn(const SR_OutHashTable* out, SR_InHashTable* in) {
   in->id = out->id;
+  in->windowSize = out->windowSize;
 
   uint32_t index = 0;
   for (uint32_t i = 0; i != out->numHashes; ++i) {
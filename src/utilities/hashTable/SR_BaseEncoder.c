@@ -0,0 +1,219 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SR_BaseEncoder.c
+ *
+ *    Description:  2-bit encoding of sequences and rolling hash key generation
+ *
+ *        Version:  1.0
+ *        Created:  10/19/2026
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ * =====================================================================================
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "utilities/common/SR_Error.h"
+#include "SR_BaseEncoder.h"
+
+static inline unsigned char EncodeBase(char base)
+{
+    switch (base)
+    {
+        case 'A': case 'a': return 0;
+        case 'C': case 'c': return 1;
+        case 'G': case 'g': return 2;
+        case 'T': case 't': return 3;
+        default: return INVALID_BASE_CODE;
+    }
+}
+
+// make room for the codes and the keys of a sequence
+static void ReserveHashKeys(SR_HashKeyArray* pHashKeys, uint32_t seqLen, unsigned char hashSize)
+{
+    if (pHashKeys->codeCapacity < seqLen)
+    {
+        free(pHashKeys->codes);
+        pHashKeys->codeCapacity = 2 * seqLen;
+        pHashKeys->codes = (unsigned char*) malloc(pHashKeys->codeCapacity);
+        if (pHashKeys->codes == NULL)
+            SR_ErrSys("ERROR: Not enough memory for the codes in a hash key array object.\n");
+    }
+
+    uint32_t maxKeys = seqLen >= hashSize ? seqLen - hashSize + 1 : 0;
+    if (pHashKeys->capacity < maxKeys)
+    {
+        free(pHashKeys->pos);
+        free(pHashKeys->keys);
+        pHashKeys->capacity = 2 * maxKeys;
+        pHashKeys->pos = (uint32_t*) malloc(sizeof(uint32_t) * pHashKeys->capacity);
+        pHashKeys->keys = (uint64_t*) malloc(sizeof(uint64_t) * pHashKeys->capacity);
+        if (pHashKeys->pos == NULL || pHashKeys->keys == NULL)
+            SR_ErrSys("ERROR: Not enough memory for the keys in a hash key array object.\n");
+    }
+}
+
+
+//===============================
+// Constructors and Destructors
+//===============================
+
+SR_HashKeyArray* SR_HashKeyArrayAlloc(void)
+{
+    SR_HashKeyArray* pNewArray = (SR_HashKeyArray*) calloc(1, sizeof(SR_HashKeyArray));
+    if (pNewArray == NULL)
+        SR_ErrSys("ERROR: Not enough memory for a hash key array object.\n");
+
+    return pNewArray;
+}
+
+void SR_HashKeyArrayFree(SR_HashKeyArray* pHashKeys)
+{
+    if (pHashKeys != NULL)
+    {
+        free(pHashKeys->pos);
+        free(pHashKeys->keys);
+        free(pHashKeys->codes);
+
+        free(pHashKeys);
+    }
+}
+
+
+//===============================
+// Interface functions
+//===============================
+
+void SR_EncodeBases(unsigned char* codes, const char* seq, uint32_t seqLen)
+{
+    uint32_t i = 0;
+
+#ifdef __SSE2__
+    const __m128i upperMask = _mm_set1_epi8((char) 0xdf);
+    const __m128i baseA = _mm_set1_epi8('A');
+    const __m128i baseC = _mm_set1_epi8('C');
+    const __m128i baseG = _mm_set1_epi8('G');
+    const __m128i baseT = _mm_set1_epi8('T');
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i two = _mm_set1_epi8(2);
+    const __m128i three = _mm_set1_epi8(3);
+    const __m128i invalid = _mm_set1_epi8(INVALID_BASE_CODE);
+
+    for (; i + 16 <= seqLen; i += 16)
+    {
+        __m128i bases = _mm_and_si128(_mm_loadu_si128((const __m128i*) (seq + i)), upperMask);
+        __m128i isA = _mm_cmpeq_epi8(bases, baseA);
+        __m128i isC = _mm_cmpeq_epi8(bases, baseC);
+        __m128i isG = _mm_cmpeq_epi8(bases, baseG);
+        __m128i isT = _mm_cmpeq_epi8(bases, baseT);
+
+        __m128i result = _mm_or_si128(_mm_and_si128(isC, one), _mm_and_si128(isG, two));
+        result = _mm_or_si128(result, _mm_and_si128(isT, three));
+
+        __m128i isValid = _mm_or_si128(_mm_or_si128(isA, isC), _mm_or_si128(isG, isT));
+        result = _mm_or_si128(result, _mm_andnot_si128(isValid, invalid));
+
+        _mm_storeu_si128((__m128i*) (codes + i), result);
+    }
+#endif
+
+    for (; i < seqLen; ++i)
+        codes[i] = EncodeBase(seq[i]);
+}
+
+void SR_HashKeyArrayLoad(SR_HashKeyArray* pHashKeys, const char* seq, uint32_t seqLen, unsigned char hashSize)
+{
+    ReserveHashKeys(pHashKeys, seqLen, hashSize);
+    SR_EncodeBases(pHashKeys->codes, seq, seqLen);
+
+    // roll the key over the codes; an invalid base restarts it
+    const unsigned char* codes = pHashKeys->codes;
+    const uint64_t mask = ((uint64_t) 1 << (2 * hashSize)) - 1;
+    uint64_t hashKey = 0;
+    uint32_t validBases = 0;
+    uint32_t size = 0;
+
+    for (uint32_t i = 0; i != seqLen; ++i)
+    {
+        unsigned char code = codes[i];
+        if (code == INVALID_BASE_CODE)
+        {
+            validBases = 0;
+            hashKey = 0;
+            continue;
+        }
+
+        hashKey = (hashKey << 2 | code) & mask;
+        if (++validBases >= hashSize)
+        {
+            pHashKeys->pos[size] = i + 1 - hashSize;
+            pHashKeys->keys[size] = hashKey;
+            ++size;
+        }
+    }
+
+    pHashKeys->size = size;
+}
+
+void SR_HashKeyArrayLoadBothStrands(SR_HashKeyArray* pHashKeys, SR_HashKeyArray* pRevCompKeys, const char* seq, uint32_t seqLen, unsigned char hashSize)
+{
+    ReserveHashKeys(pHashKeys, seqLen, hashSize);
+    ReserveHashKeys(pRevCompKeys, seqLen, hashSize);
+    SR_EncodeBases(pHashKeys->codes, seq, seqLen);
+
+    // roll the key and the key of its reverse complement together
+    const unsigned char* codes = pHashKeys->codes;
+    const uint64_t mask = ((uint64_t) 1 << (2 * hashSize)) - 1;
+    const unsigned int highShift = 2 * (hashSize - 1);
+    uint64_t hashKey = 0;
+    uint64_t revCompKey = 0;
+    uint32_t validBases = 0;
+    uint32_t size = 0;
+
+    for (uint32_t i = 0; i != seqLen; ++i)
+    {
+        unsigned char code = codes[i];
+        if (code == INVALID_BASE_CODE)
+        {
+            validBases = 0;
+            hashKey = 0;
+            revCompKey = 0;
+            continue;
+        }
+
+        hashKey = (hashKey << 2 | code) & mask;
+        revCompKey = revCompKey >> 2 | (uint64_t) (3 - code) << highShift;
+        if (++validBases >= hashSize)
+        {
+            pHashKeys->pos[size] = i + 1 - hashSize;
+            pHashKeys->keys[size] = hashKey;
+
+            // the hash ends at seqLen - 1 - i in the reverse complement
+            pRevCompKeys->pos[size] = seqLen - 1 - i;
+            pRevCompKeys->keys[size] = revCompKey;
+            ++size;
+        }
+    }
+
+    pHashKeys->size = size;
+    pRevCompKeys->size = size;
+
+    // store the keys of the reverse complement in increasing position order as well
+    for (uint32_t i = 0, j = size; i + 1 < j; ++i, --j)
+    {
+        uint32_t tempPos = pRevCompKeys->pos[i];
+        pRevCompKeys->pos[i] = pRevCompKeys->pos[j - 1];
+        pRevCompKeys->pos[j - 1] = tempPos;
+
+        uint64_t tempKey = pRevCompKeys->keys[i];
+        pRevCompKeys->keys[i] = pRevCompKeys->keys[j - 1];
+        pRevCompKeys->keys[j - 1] = tempKey;
+    }
+}
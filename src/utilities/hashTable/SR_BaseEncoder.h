@@ -0,0 +1,112 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SR_BaseEncoder.h
+ *
+ *    Description:  2-bit encoding of sequences and rolling hash key generation
+ *
+ *        Version:  1.0
+ *        Created:  10/19/2026
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ * =====================================================================================
+ */
+#ifndef  SR_BASEENCODER_H
+#define  SR_BASEENCODER_H
+
+#include <stdint.h>
+
+//===============================
+// Type and constant definition
+//===============================
+
+// code of a base other than ACGT. codes of valid bases are 0 - 3
+#define INVALID_BASE_CODE 4
+
+// hash keys of a sequence
+typedef struct SR_HashKeyArray
+{
+    uint32_t* pos;             // start position of each hash in the sequence
+
+    uint64_t* keys;            // hash key of each hash
+
+    unsigned char* codes;      // 2-bit codes of the sequence
+
+    uint32_t size;             // number of hashes
+
+    uint32_t capacity;         // capacity of "pos" and "keys"
+
+    uint32_t codeCapacity;     // capacity of "codes"
+
+}SR_HashKeyArray;
+
+
+//===============================
+// Constructors and Destructors
+//===============================
+
+SR_HashKeyArray* SR_HashKeyArrayAlloc(void);
+
+void SR_HashKeyArrayFree(SR_HashKeyArray* pHashKeys);
+
+
+//===============================
+// Interface functions
+//===============================
+
+//=====================================================================
+// function:
+//      translate a sequence into 2-bit codes
+//
+// args:
+//      1. codes: output, at least seqLen bytes
+//      2. seq: the sequence (upper or lower case)
+//      3. seqLen: length of the sequence
+//
+// discussion:
+//      A, C, G and T get 0, 1, 2 and 3, any other character gets
+//      INVALID_BASE_CODE. 16 bases are translated at a time with SSE2
+//=====================================================================
+void SR_EncodeBases(unsigned char* codes, const char* seq, uint32_t seqLen);
+
+//=====================================================================
+// function:
+//      get the hash keys of all the hashes in a sequence
+//
+// args:
+//      1. pHashKeys: a pointer to a hash key array; the keys of the
+//                    sequence replace its content
+//      2. seq: the sequence
+//      3. seqLen: length of the sequence
+//      4. hashSize: size of hash (up to MAX_LONG_HASH_SIZE)
+//
+// discussion:
+//      the sequence is encoded with SR_EncodeBases and the keys are
+//      rolled over the codes. hashes containing an invalid base are
+//      skipped; the rest are stored in increasing position order
+//=====================================================================
+void SR_HashKeyArrayLoad(SR_HashKeyArray* pHashKeys, const char* seq, uint32_t seqLen, unsigned char hashSize);
+
+//=====================================================================
+// function:
+//      SR_HashKeyArrayLoad for a sequence and its reverse complement
+//      in one pass
+//
+// args:
+//      1. pHashKeys: a pointer to a hash key array; the keys of the
+//                    sequence replace its content
+//      2. pRevCompKeys: a pointer to a hash key array; the keys of the
+//                       reverse complement of the sequence replace
+//                       its content
+//      3. seq: the sequence
+//      4. seqLen: length of the sequence
+//      5. hashSize: size of hash (up to MAX_LONG_HASH_SIZE)
+//
+// discussion:
+//      both arrays are the same as SR_HashKeyArrayLoad gives for each
+//      strand; the sequence is only encoded once, into pHashKeys
+//=====================================================================
+void SR_HashKeyArrayLoadBothStrands(SR_HashKeyArray* pHashKeys, SR_HashKeyArray* pRevCompKeys, const char* seq, uint32_t seqLen, unsigned char hashSize);
+
+#endif  /*SR_BASEENCODER_H*/
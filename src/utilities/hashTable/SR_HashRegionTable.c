@@ -23,190 +23,192 @@
 
 #include "utilities/common/SR_Error.h"
 #include "utilities/common/SR_Utilities.h"
+#include "SR_BaseEncoder.h"
+#include "SR_Minimizer.h"
 #include "SR_HashRegionTable.h"
 
 // default capacity of a hash region array
 const int DEFAULT_HASH_ARR_CAPACITY = 50;
 
+// default number of slots in the open region table; must be a power of 2
+const unsigned int DEFAULT_OPEN_REGION_CAPACITY = 256;
+
 //=========================
 // Static methods
 //=========================
 
+// set up the best regions of a newly allocated best hash region array
+static void InitBestRegions(BestRegionArray* pBestRegions)
+{
+    for (unsigned int i = 0; i != pBestRegions->capacity; ++i)
+    {
+        BestRegion* tempRegion = pBestRegions->data + i;
+        tempRegion->queryBegin = i;
+        tempRegion->length     = 0;
+        tempRegion->numPos     = 0;
+    }
+}
+
 // intialize the best hash region array
+// only the best regions touched by the previous query are cleared
 static void ResetBestRegions(HashRegionTable* pRegionTable, unsigned short queryLen)
 {
-
-    if (pRegionTable->pBestCloseRegions == NULL)
+    if (pRegionTable->pBestCloseRegions == NULL || (pRegionTable->pBestCloseRegions)->capacity < queryLen)
     {
-        SR_ARRAY_ALLOC(pRegionTable->pBestCloseRegions, queryLen, BestRegionArray, BestRegion);
-        SR_ARRAY_ALLOC(pRegionTable->pBestFarRegions, queryLen, BestRegionArray, BestRegion);
+        unsigned int capacity = pRegionTable->pBestCloseRegions == NULL ? queryLen : 2 * queryLen;
 
-        for (unsigned int i = 0; i != queryLen; ++i)
-        {
-            BestRegion* tempRegion = pRegionTable->pBestCloseRegions->data + i;
-            tempRegion->queryBegin = i;
+        SR_ARRAY_FREE(pRegionTable->pBestCloseRegions, TRUE);
+        SR_ARRAY_FREE(pRegionTable->pBestFarRegions, TRUE);
+        SR_ARRAY_ALLOC(pRegionTable->pBestCloseRegions, capacity, BestRegionArray, BestRegion);
+        SR_ARRAY_ALLOC(pRegionTable->pBestFarRegions, capacity, BestRegionArray, BestRegion);
 
-            tempRegion = pRegionTable->pBestFarRegions->data + i;
-            tempRegion->queryBegin = i;
-        }
+        InitBestRegions(pRegionTable->pBestCloseRegions);
+        InitBestRegions(pRegionTable->pBestFarRegions);
     }
-
-    SR_Bool isSmall = FALSE;
-    if ((pRegionTable->pBestCloseRegions)->capacity < queryLen)
-    {
-        isSmall = TRUE;
-        SR_ARRAY_FREE(pRegionTable->pBestCloseRegions, FALSE);
-        SR_ARRAY_FREE(pRegionTable->pBestFarRegions, FALSE);
-    }
-
-    if ((pRegionTable->pBestCloseRegions)->data == NULL)
+    else
     {
-        unsigned int capacity = isSmall ? 2 * queryLen : queryLen;
-
-        SR_ARRAY_INIT(pRegionTable->pBestCloseRegions, capacity, BestRegion);
-        SR_ARRAY_INIT(pRegionTable->pBestFarRegions, capacity, BestRegion);
-
-        for (unsigned int i = 0; i != capacity; ++i)
+        for (unsigned int i = 0; i != SR_ARRAY_GET_SIZE(pRegionTable->pTouched); ++i)
         {
-            BestRegion* tempRegion = pRegionTable->pBestCloseRegions->data + i;
-            tempRegion->queryBegin = i;
+            uint32_t queryBegin = SR_ARRAY_GET(pRegionTable->pTouched, i);
+
+            BestRegion* tempRegion = pRegionTable->pBestCloseRegions->data + queryBegin;
+            tempRegion->queryBegin = queryBegin;
+            tempRegion->length     = 0;
+            tempRegion->numPos     = 0;
 
-            tempRegion = pRegionTable->pBestFarRegions->data + i;
-            tempRegion->queryBegin = i;
+            tempRegion = pRegionTable->pBestFarRegions->data + queryBegin;
+            tempRegion->queryBegin = queryBegin;
+            tempRegion->length     = 0;
+            tempRegion->numPos     = 0;
         }
     }
 
+    SR_ARRAY_RESET(pRegionTable->pTouched);
+    pRegionTable->numTopRegions = 0;
+
     (pRegionTable->pBestCloseRegions)->size = queryLen;
     (pRegionTable->pBestFarRegions)->size = queryLen;
+}
 
-    for (unsigned int i = 0; i != queryLen; ++i)
-    {
-        BestRegion* tempRegion = pRegionTable->pBestCloseRegions->data + i;
-        tempRegion->length     = 0;
-        tempRegion->numPos     = 0;
-	//tempRegion->queryBegin = i;
-	//for (unsigned int j = 0; j < MAX_BEST_REF_BEGINS; ++j)
-	//  tempRegion->refBegins[j] = 0;
+// is the first best region longer than the second one
+static inline SR_Bool IsBetterRegion(const BestRegion* pFirst, const BestRegion* pSecond)
+{
+    if (pFirst->length != pSecond->length)
+        return pFirst->length > pSecond->length;
 
-        tempRegion = pRegionTable->pBestFarRegions->data + i;
-        tempRegion->length     = 0;
-        tempRegion->numPos     = 0;
-	//tempRegion->queryBegin = i;
-	//for (unsigned int j = 0; j < MAX_BEST_REF_BEGINS; ++j)
-	//  tempRegion->refBegins[j] = 0;
-    }
+    return pFirst->queryBegin < pSecond->queryBegin;
 }
 
-
-// calculate the hash key for a hash in a read that starts at a certain position
-static SR_Bool GetNextHashKey(const char* query, uint32_t queryLen, unsigned int* pPos, uint32_t* pHashKey, uint32_t mask, unsigned int hashSize)
+// a close best region just got longer; move it into its place in the top regions
+static void UpdateTopRegions(HashRegionTable* pRegionTable, BestRegion* pBestClose)
 {
-    // table use to translate a nucleotide into its corresponding 2-bit representation
-    static const char translation[26] = { 0, -1, 1, -1, -1, -1, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 3, -1, -1, -1, -1, -1, -1 };
+    BestRegion** pTopRegions = pRegionTable->pTopRegions;
 
-    unsigned int endPos = *pPos + hashSize;
-    unsigned int startPos = *pPos == 0 ? *pPos : endPos - 1;
+    unsigned int pos = 0;
+    while (pos != pRegionTable->numTopRegions && pTopRegions[pos] != pBestClose)
+        ++pos;
 
-    // remove the highest 2 bits in the previous hash key
-    *pHashKey &= mask;
+    if (pos == pRegionTable->numTopRegions)
+    {
+        if (pRegionTable->numTopRegions < MAX_TOP_REGIONS)
+            ++(pRegionTable->numTopRegions);
+        else if (!IsBetterRegion(pBestClose, pTopRegions[MAX_TOP_REGIONS - 1]))
+            return;
+        else
+            pos = MAX_TOP_REGIONS - 1;
+    }
 
-    while (endPos <= queryLen)
+    // its length only grows, so it can only move towards the front
+    while (pos > 0 && IsBetterRegion(pBestClose, pTopRegions[pos - 1]))
     {
-        char tValue = 0;
-        for (unsigned int i = startPos; i != endPos; ++i)
-        {
-            tValue = translation[query[i] - 'A'];
-            if (tValue < 0)
-            {
-                *pHashKey = 0;
-                *pPos = i + 1;
-                startPos = *pPos;
-                endPos = startPos + hashSize;
-                break;
-            }
+        pTopRegions[pos] = pTopRegions[pos - 1];
+        --pos;
+    }
 
-            *pHashKey = (*pHashKey) << 2 | tValue;
-        }
+    pTopRegions[pos] = pBestClose;
+}
 
-        if (tValue >= 0)
-            return TRUE;
-    }
+// (re)allocate the slots of the open region table
+static void InitOpenRegions(OpenRegionTable* pOpenRegions, unsigned int capacity)
+{
+    free(pOpenRegions->data);
+    pOpenRegions->data = (OpenRegion*) calloc(capacity, sizeof(OpenRegion));
+    if (pOpenRegions->data == NULL)
+        SR_ErrSys("ERROR: not enough memory for the open region table.\n");
+
+    pOpenRegions->size = 0;
+    pOpenRegions->capacity = capacity;
+    pOpenRegions->shift = 64;
+    for (unsigned int i = capacity; i > 1; i >>= 1)
+        --(pOpenRegions->shift);
+
+    // generation 0 marks an empty slot
+    pOpenRegions->generation = 1;
+}
 
-    return FALSE;
+// start a new query; all the open regions of the previous query are dropped
+static void ResetOpenRegions(OpenRegionTable* pOpenRegions)
+{
+    pOpenRegions->size = 0;
+    ++(pOpenRegions->generation);
+    if (pOpenRegions->generation == 0)
+        InitOpenRegions(pOpenRegions, pOpenRegions->capacity);
+}
+
+static inline OpenRegion* ProbeOpenRegion(const OpenRegionTable* pOpenRegions, int64_t diagonal)
+{
+    unsigned int mask = pOpenRegions->capacity - 1;
+    unsigned int i = (unsigned int) (((uint64_t) diagonal * 0x9E3779B97F4A7C15ULL) >> pOpenRegions->shift);
+    while (pOpenRegions->data[i].generation == pOpenRegions->generation && pOpenRegions->data[i].diagonal != diagonal)
+        i = (i + 1) & mask;
+
+    return pOpenRegions->data + i;
 }
 
-// find the start index of the first hash position that is in our search region
-static unsigned int GetStartHashPosIndex(const HashPosView* pHashPosView, uint32_t refStart)
+// double the slots and move the valid entries over
+static void GrowOpenRegions(OpenRegionTable* pOpenRegions)
 {
-    unsigned int min = 0;
-    unsigned int max = pHashPosView->size - 1;
+    OpenRegionTable oldRegions = *pOpenRegions;
+    pOpenRegions->data = NULL;
+    InitOpenRegions(pOpenRegions, 2 * oldRegions.capacity);
 
-    unsigned int mid;
-    while (min <= max)
+    for (unsigned int i = 0; i != oldRegions.capacity; ++i)
     {
-        mid = (min + max) / 2;
-        
-        if (refStart == pHashPosView->data[mid])
-            return mid;
-        else if (refStart > pHashPosView->data[mid])
-            min = mid + 1;
-        else
+        if (oldRegions.data[i].generation == oldRegions.generation)
         {
-            if (mid == 0)
-                break;
-
-            max = mid - 1;
+            OpenRegion* pSlot = ProbeOpenRegion(pOpenRegions, oldRegions.data[i].diagonal);
+            *pSlot = oldRegions.data[i];
+            pSlot->generation = pOpenRegions->generation;
+            ++(pOpenRegions->size);
         }
     }
 
-    if (pHashPosView->data[mid] > refStart)
-        return mid;
-    else
-        return mid + 1;
+    free(oldRegions.data);
 }
 
-
-// merge a new hash region with existing ones
-static SR_Bool MergeHashRegions(HashRegionTable* pRegionTable, HashRegion* pNewRegion)
+// get the open region on a diagonal. a new entry is claimed if there is none
+static SR_Bool GetOpenRegion(OpenRegion** ppOpenRegion, OpenRegionTable* pOpenRegions, int64_t diagonal)
 {
-    if (pNewRegion->refBegin < SR_ARRAY_GET(pRegionTable->pPrevRegions, 0).refBegin)
+    OpenRegion* pSlot = ProbeOpenRegion(pOpenRegions, diagonal);
+    if (pSlot->generation == pOpenRegions->generation)
+    {
+        *ppOpenRegion = pSlot;
         return TRUE;
+    }
 
-    uint32_t target = pNewRegion->refBegin + pNewRegion->length - 1;
-    unsigned int min = pRegionTable->searchBegin;
-    unsigned int max = (pRegionTable->pPrevRegions)->size - 1;
-
-    if (min > max)
-        return FALSE;
-
-    while (min <= max)
+    // keep the load factor under 1/2
+    if (2 * (pOpenRegions->size + 1) > pOpenRegions->capacity)
     {
-        unsigned int mid = (min + max) / 2;
-        uint32_t refEnd = SR_ARRAY_GET(pRegionTable->pPrevRegions, mid).refBegin + SR_ARRAY_GET(pRegionTable->pPrevRegions, mid).length;
-
-        if (target == refEnd)
-        {
-            pRegionTable->searchBegin = mid + 1;
-            pNewRegion->refBegin = SR_ARRAY_GET(pRegionTable->pPrevRegions, mid).refBegin;
-            pNewRegion->queryBegin = SR_ARRAY_GET(pRegionTable->pPrevRegions, mid).queryBegin;
-            pNewRegion->length = SR_ARRAY_GET(pRegionTable->pPrevRegions, mid).length + 1;
-            break;
-        }
-        else if (target > refEnd)
-        {
-            min = mid + 1;
-            pRegionTable->searchBegin = min;
-        }
-        else
-        {
-            if (mid == 0)
-                return TRUE;
-
-            max = mid - 1;
-        }
+        GrowOpenRegions(pOpenRegions);
+        pSlot = ProbeOpenRegion(pOpenRegions, diagonal);
     }
 
-    return TRUE;
+    pSlot->generation = pOpenRegions->generation;
+    pSlot->diagonal = diagonal;
+    ++(pOpenRegions->size);
+
+    *ppOpenRegion = pSlot;
+    return FALSE;
 }
 
 // update the best hash regions after each merge
@@ -217,6 +219,9 @@ static void UpdateBestRegions(HashRegionTable* pRegionTable, const HashRegion* p
 
     if (pNewRegion->length > pBestFar->length)
     {
+        if (pBestFar->length == 0)
+            SR_ARRAY_PUSH(pRegionTable->pTouched, &(pNewRegion->queryBegin), uint32_t);
+
         pBestFar->length = pNewRegion->length;
         pBestFar->refBegins[0] = pNewRegion->refBegin;
         pBestFar->numPos = 1;
@@ -237,6 +242,8 @@ static void UpdateBestRegions(HashRegionTable* pRegionTable, const HashRegion* p
             pBestClose->length = pNewRegion->length;
             pBestClose->refBegins[0] = pNewRegion->refBegin;
             pBestClose->numPos = 1;
+
+            UpdateTopRegions(pRegionTable, pBestClose);
         }
         else if (pNewRegion->length == pBestClose->length)
         {
@@ -249,6 +256,136 @@ static void UpdateBestRegions(HashRegionTable* pRegionTable, const HashRegion* p
 }
 
 
+// store a query minimizer found by SR_MinimizerScan
+static void PushQuerySeed(void* pData, uint32_t pos, uint64_t hashKey)
+{
+    HashSeedArray* pQuerySeeds = (HashSeedArray*) pData;
+    HashSeed newSeed;
+    newSeed.queryBegin = pos;
+    newSeed.hashKey = hashKey;
+
+    SR_ARRAY_PUSH(pQuerySeeds, &newSeed, HashSeed);
+}
+
+// get the hash keys of the query; only its minimizers if the hash table only holds minimizers
+static void LoadQueryKeys(HashRegionTable* pRegionTable, const SR_InHashTable* pHashTable, const SR_QueryRegion* pQueryRegion)
+{
+    if (pHashTable->windowSize > 1)
+    {
+        SR_ARRAY_RESET(pRegionTable->pQuerySeeds);
+        SR_MinimizerScan(pQueryRegion->orphanSeq, SR_GetQueryLen(pQueryRegion->pOrphan), pHashTable->hashSize, 
+                         pHashTable->windowSize, PushQuerySeed, pRegionTable->pQuerySeeds);
+    }
+    else
+    {
+        SR_HashKeyArrayLoad(pRegionTable->pQueryKeys, pQueryRegion->orphanSeq, SR_GetQueryLen(pQueryRegion->pOrphan), pHashTable->hashSize);
+    }
+}
+
+// the reverse complement of the current orphan sequence of a query region
+static const char* GetRevCompSeq(const SR_QueryRegion* pQueryRegion)
+{
+    if (pQueryRegion->orphanSeq == pQueryRegion->orphanSeqReverseComplament)
+        return pQueryRegion->orphanSeqForward;
+    else if (pQueryRegion->orphanSeq == pQueryRegion->orphanSeqReverse)
+        return pQueryRegion->orphanSeqComplement;
+    else if (pQueryRegion->orphanSeq == pQueryRegion->orphanSeqComplement)
+        return pQueryRegion->orphanSeqReverse;
+
+    return pQueryRegion->orphanSeqReverseComplament;
+}
+
+// SeedQuery for a hash table that only holds minimizers.
+// A hit extends the open region on its diagonal if the last hit of
+// that region is at most windowSize bases before it in the query.
+static void SeedQueryMinimizers(HashRegionTable* pRegionTable, const SR_InHashTable* pHashTable, const SR_QueryRegion* pQueryRegion)
+{
+    for (unsigned int s = 0; s != SR_ARRAY_GET_SIZE(pRegionTable->pQuerySeeds); ++s)
+    {
+        const HashSeed* pSeed = SR_ARRAY_GET_PT(pRegionTable->pQuerySeeds, s);
+        HashPosView hashPosArray;
+        if (!SR_InHashTableSearchRange(&hashPosArray, pHashTable, pSeed->hashKey, pQueryRegion->farRefBegin, pQueryRegion->farRefEnd))
+        {
+            if (pHashTable->numMaskedHashes > 0 && SR_InHashTableIsMasked(pHashTable, pSeed->hashKey))
+                ++(pRegionTable->numMaskedSeeds);
+
+            continue;
+        }
+
+        for (unsigned int i = 0; i != hashPosArray.size; ++i)
+        {
+            int64_t diagonal = (int64_t) hashPosArray.data[i] - pSeed->queryBegin;
+            OpenRegion* pOpenRegion = NULL;
+            if (GetOpenRegion(&pOpenRegion, &(pRegionTable->openRegions), diagonal)
+                && pOpenRegion->lastQueryBegin + pHashTable->windowSize >= pSeed->queryBegin)
+            {
+                pOpenRegion->region.length = pSeed->queryBegin + pHashTable->hashSize - pOpenRegion->region.queryBegin;
+            }
+            else
+            {
+                pOpenRegion->region.queryBegin = pSeed->queryBegin;
+                pOpenRegion->region.refBegin = hashPosArray.data[i];
+                pOpenRegion->region.length = pHashTable->hashSize;
+            }
+
+            pOpenRegion->lastQueryBegin = pSeed->queryBegin;
+            UpdateBestRegions(pRegionTable, &(pOpenRegion->region), pQueryRegion);
+        }
+    }
+}
+
+// seed the hash keys of a query loaded by LoadQueryKeys
+static void SeedQuery(HashRegionTable* pRegionTable, const SR_InHashTable* pHashTable, const SR_QueryRegion* pQueryRegion)
+{
+    if (pHashTable->windowSize > 1)
+    {
+        SeedQueryMinimizers(pRegionTable, pHashTable, pQueryRegion);
+        return;
+    }
+
+    for (uint32_t j = 0; j != pRegionTable->pQueryKeys->size; ++j)
+    {
+        uint32_t currQueryPos = pRegionTable->pQueryKeys->pos[j];
+        uint64_t hashKey = pRegionTable->pQueryKeys->keys[j];
+
+        // an array stores the hash positions under current hash key
+        HashPosView hashPosArray;
+
+        // only the hash positions within our search region are returned
+        if (SR_InHashTableSearchRange(&hashPosArray, pHashTable, hashKey, pQueryRegion->farRefBegin, pQueryRegion->farRefEnd))
+        {
+            for (unsigned int i = 0; i != hashPosArray.size; ++i)
+            {
+                // the hit extends the region on its diagonal if that region got a hit 1bp before in the query
+                // otherwise a new region starts here
+                int64_t diagonal = (int64_t) hashPosArray.data[i] - currQueryPos;
+                OpenRegion* pOpenRegion = NULL;
+                if (GetOpenRegion(&pOpenRegion, &(pRegionTable->openRegions), diagonal)
+                    && pOpenRegion->lastQueryBegin + 1 == currQueryPos)
+                {
+                    ++(pOpenRegion->region.length);
+                }
+                else
+                {
+                    pOpenRegion->region.queryBegin = currQueryPos;
+                    pOpenRegion->region.refBegin = hashPosArray.data[i];
+                    pOpenRegion->region.length = pHashTable->hashSize;
+                }
+
+                pOpenRegion->lastQueryBegin = currQueryPos;
+
+                // we will update the best hash region with this new region
+                UpdateBestRegions(pRegionTable, &(pOpenRegion->region), pQueryRegion);
+            }
+        }
+        else if (pHashTable->numMaskedHashes > 0 && SR_InHashTableIsMasked(pHashTable, hashKey))
+        {
+            ++(pRegionTable->numMaskedSeeds);
+        }
+    }
+}
+
+
 //===============================
 // Constructors and Destructors
 //===============================
@@ -259,13 +396,17 @@ HashRegionTable* HashRegionTableAlloc(void)
     if (pNewTable == NULL)
         SR_ErrSys("ERROR: not enough memory for a new hash region table object.\n");
 
-    SR_ARRAY_ALLOC(pNewTable->pPrevRegions, DEFAULT_HASH_ARR_CAPACITY, HashRegionArray, HashRegion);
-    SR_ARRAY_ALLOC(pNewTable->pCurrRegions, DEFAULT_HASH_ARR_CAPACITY, HashRegionArray, HashRegion);
+    pNewTable->openRegions.data = NULL;
+    InitOpenRegions(&(pNewTable->openRegions), DEFAULT_OPEN_REGION_CAPACITY);
+    SR_ARRAY_ALLOC(pNewTable->pQuerySeeds, DEFAULT_HASH_ARR_CAPACITY, HashSeedArray, HashSeed);
+    pNewTable->pQueryKeys = SR_HashKeyArrayAlloc();
 
     pNewTable->pBestCloseRegions = NULL;
     pNewTable->pBestFarRegions = NULL;
+    SR_ARRAY_ALLOC(pNewTable->pTouched, DEFAULT_HASH_ARR_CAPACITY, TouchedArray, uint32_t);
+    pNewTable->numTopRegions = 0;
 
-    pNewTable->searchBegin = 0;
+    pNewTable->numMaskedSeeds = 0;
 
     return pNewTable;
 }
@@ -274,10 +415,12 @@ void HashRegionTableFree(HashRegionTable* pRegionTable)
 {
     if (pRegionTable != NULL)
     {
-        SR_ARRAY_FREE(pRegionTable->pPrevRegions, TRUE);
-        SR_ARRAY_FREE(pRegionTable->pCurrRegions, TRUE);
+        free(pRegionTable->openRegions.data);
         SR_ARRAY_FREE(pRegionTable->pBestCloseRegions, TRUE);
         SR_ARRAY_FREE(pRegionTable->pBestFarRegions, TRUE);
+        SR_ARRAY_FREE(pRegionTable->pTouched, TRUE);
+        SR_ARRAY_FREE(pRegionTable->pQuerySeeds, TRUE);
+        SR_HashKeyArrayFree(pRegionTable->pQueryKeys);
 
         free(pRegionTable);
     }
@@ -291,74 +434,58 @@ void HashRegionTableFree(HashRegionTable* pRegionTable)
 // for each query find the best hash regions in the reference
 void HashRegionTableLoad(HashRegionTable* pRegionTable, const SR_InHashTable* pHashTable, const SR_QueryRegion* pQueryRegion)
 {
-    unsigned int prevQueryPos = 0;
-    unsigned int currQueryPos = 0;
-    uint32_t hashKey = 0;
-
-    // get the next hash key in the query
-    while (GetNextHashKey(pQueryRegion->orphanSeq, SR_GetQueryLen(pQueryRegion->pOrphan), &currQueryPos, &hashKey, pHashTable->highEndMask, pHashTable->hashSize))
-    {
-        // an array stores the hash positions under current hash key
-        HashPosView hashPosArray;
-        // this struct will store the new hash region from the query
-        HashRegion newRegion;
-
-        if (SR_InHashTableSearch(&hashPosArray, pHashTable, hashKey))
-        {
-
-            // we only have to merge the hash regions when we do get some hash regions in the last round
-            // and the current query position is 1bp ahead the previous query position
-            SR_Bool doMerge = FALSE;
-            if (currQueryPos == prevQueryPos + 1 && SR_ARRAY_GET_SIZE(pRegionTable->pPrevRegions) > 0)
-                doMerge = TRUE;
+    ResetOpenRegions(&(pRegionTable->openRegions));
 
-            // find the start index of the first hash position that is in our search region
-            unsigned int startIndex = GetStartHashPosIndex(&hashPosArray, pQueryRegion->farRefBegin);
-            for (unsigned int i = startIndex; i != hashPosArray.size; ++i)
-            {
-                // initialize the new hash region
-                newRegion.queryBegin = currQueryPos;
-                newRegion.refBegin = hashPosArray.data[i];
-                newRegion.length = pHashTable->hashSize;
-
-                if (doMerge)
-                    doMerge = MergeHashRegions(pRegionTable, &newRegion);
-
-                // we will get out of the loop if the hash position in reference exceeds our search region
-                if (newRegion.refBegin > pQueryRegion->farRefEnd)
-                    break;
-
-                // we will update the best hash region with this new region and push it into the current hash region array for next round merge
-                UpdateBestRegions(pRegionTable, &newRegion, pQueryRegion);
-                SR_ARRAY_PUSH(pRegionTable->pCurrRegions, &newRegion, HashRegion);
-            }
-        }
+    // get all the hash keys in the query at once
+    LoadQueryKeys(pRegionTable, pHashTable, pQueryRegion);
+    SeedQuery(pRegionTable, pHashTable, pQueryRegion);
+}
 
-        // we are done with the previos hash region array
-        // we will clear it and swap it with the current hash region array
-        SR_ARRAY_RESET(pRegionTable->pPrevRegions);
-        SR_SWAP(pRegionTable->pPrevRegions, pRegionTable->pCurrRegions, HashRegionArray*);
-        pRegionTable->searchBegin = 0;
+// find the best hash regions of the query and of its reverse complement
+void HashRegionTableLoadBothStrands(HashRegionTable* pRegionTable, HashRegionTable* pRevCompTable, 
+                                   const SR_InHashTable* pHashTable, const SR_QueryRegion* pQueryRegion)
+{
+    ResetOpenRegions(&(pRegionTable->openRegions));
+    ResetOpenRegions(&(pRevCompTable->openRegions));
 
-        // move to the next hash position in query
-        prevQueryPos = currQueryPos;
-        ++currQueryPos;
+    uint32_t queryLen = SR_GetQueryLen(pQueryRegion->pOrphan);
+    if (pHashTable->windowSize > 1)
+    {
+        // the minimizers of the two strands are not the same hashes, so each strand is scanned
+        LoadQueryKeys(pRegionTable, pHashTable, pQueryRegion);
+        SR_ARRAY_RESET(pRevCompTable->pQuerySeeds);
+        SR_MinimizerScan(GetRevCompSeq(pQueryRegion), queryLen, pHashTable->hashSize, 
+                         pHashTable->windowSize, PushQuerySeed, pRevCompTable->pQuerySeeds);
     }
+    else
+    {
+        SR_HashKeyArrayLoadBothStrands(pRegionTable->pQueryKeys, pRevCompTable->pQueryKeys, 
+                                       pQueryRegion->orphanSeq, queryLen, pHashTable->hashSize);
+    }
+
+    // both strands are searched in the same range
+    SeedQuery(pRegionTable, pHashTable, pQueryRegion);
+    SeedQuery(pRevCompTable, pHashTable, pQueryRegion);
 }
 
 // index the best hash regions with their end position
 void HashRegionTableReverseBest(HashRegionTable* pRegionTable)
 {
+    pRegionTable->numTopRegions = 0;
+
     for (int i = SR_ARRAY_GET_SIZE(pRegionTable->pBestCloseRegions) - 1; i >= 0; --i)
     {
         BestRegion* pCloseLowEnd = SR_ARRAY_GET_PT(pRegionTable->pBestCloseRegions, i);
         if (pCloseLowEnd->length > 0)
         {
-            unsigned short closeHighEndPos = i + pCloseLowEnd->length - 1;
+            uint32_t closeHighEndPos = i + pCloseLowEnd->length - 1;
             BestRegion* pCloseHighEnd = SR_ARRAY_GET_PT(pRegionTable->pBestCloseRegions, closeHighEndPos);
 
             if (pCloseHighEnd->length < pCloseLowEnd->length)
+            {
                 *pCloseHighEnd = *pCloseLowEnd;
+                SR_ARRAY_PUSH(pRegionTable->pTouched, &closeHighEndPos, uint32_t);
+            }
 
             pCloseLowEnd->length = 0;
         }
@@ -366,11 +493,14 @@ void HashRegionTableReverseBest(HashRegionTable* pRegionTable)
         BestRegion* pFarLowEnd = SR_ARRAY_GET_PT(pRegionTable->pBestFarRegions, i);
         if (pFarLowEnd->length > 0)
         {
-            unsigned short closeHighEndPos = i + pFarLowEnd->length - 1;
+            uint32_t closeHighEndPos = i + pFarLowEnd->length - 1;
             BestRegion* pFarHighEnd = SR_ARRAY_GET_PT(pRegionTable->pBestFarRegions, closeHighEndPos);
 
             if (pFarHighEnd->length < pFarLowEnd->length)
+            {
                 *pFarHighEnd = *pFarLowEnd;
+                SR_ARRAY_PUSH(pRegionTable->pTouched, &closeHighEndPos, uint32_t);
+            }
 
             pFarLowEnd->length = 0;
         }
@@ -381,8 +511,7 @@ void HashRegionTableReverseBest(HashRegionTable* pRegionTable)
 // initialize the hash region table for a new query
 void HashRegionTableInit(HashRegionTable* pRegionTable, uint32_t queryLen)
 {
-    SR_ARRAY_RESET(pRegionTable->pPrevRegions);
-    SR_ARRAY_RESET(pRegionTable->pCurrRegions);
+    ResetOpenRegions(&(pRegionTable->openRegions));
 
     ResetBestRegions(pRegionTable, queryLen);
 }
@@ -21,6 +21,7 @@
 
 #include "utilities/common/SR_Types.h"
 #include "SR_InHashTable.h"
+#include "SR_BaseEncoder.h"
 #include "dataStructures/SR_QueryRegion.h"
 
 //===============================
@@ -29,6 +30,9 @@
 
 #define MAX_BEST_REF_BEGINS 3
 
+// number of the longest close best regions kept in a hash region table
+#define MAX_TOP_REGIONS 8
+
 // structure hold the information of a hash region
 typedef struct HashRegion
 {
@@ -53,16 +57,52 @@ typedef struct BestRegion
 
 }BestRegion;
 
-// hash region array
-typedef struct HashRegionArray
+// a hash region that may still be extended by the hits on its diagonal
+typedef struct OpenRegion
 {
-    HashRegion* data;          // array of hash regions 
+    int64_t diagonal;          // refBegin - queryBegin of the region
+
+    uint32_t generation;       // the entry is only valid if it equals the generation of the table
+
+    uint32_t lastQueryBegin;   // query position of the last hash merged into the region
 
-    unsigned int size;         // size of the array
+    HashRegion region;         // the region itself
+
+}OpenRegion;
+
+// open addressing hash table of open regions keyed by their diagonals
+typedef struct OpenRegionTable
+{
+    OpenRegion* data;          // slots of the table
 
-    unsigned int capacity;     // maximum number of objects that can be held in the array
+    unsigned int size;         // number of valid entries
 
-}HashRegionArray;
+    unsigned int capacity;     // number of slots; a power of 2
+
+    unsigned int shift;        // 64 - log2(capacity), used to hash a diagonal
+
+    uint32_t generation;       // current generation; bumped for each query instead of clearing the slots
+
+}OpenRegionTable;
+
+// a hash of the query that is looked up in a minimizer hash table
+typedef struct HashSeed
+{
+    uint32_t queryBegin;    // begin position of the hash at a read
+
+    uint64_t hashKey;       // the hash key
+
+}HashSeed;
+
+typedef struct HashSeedArray
+{
+    HashSeed* data;
+
+    unsigned int size;
+
+    unsigned int capacity;
+
+}HashSeedArray;
 
 // best region array
 typedef struct BestRegionArray
@@ -75,18 +115,38 @@ typedef struct BestRegionArray
 
 }BestRegionArray;
 
-typedef struct HashRegionTable
+// query positions whose best regions are set
+typedef struct TouchedArray
 {
-    unsigned int searchBegin;              // lower limit in searching the prevHashArray
+    uint32_t* data;
 
-    HashRegionArray* pPrevRegions;         // an array hold the hash regions that start at 1bp before
+    unsigned int size;
+
+    unsigned int capacity;
 
-    HashRegionArray* pCurrRegions;         // an array hold the hash regions that start at current bp
+}TouchedArray;
+
+typedef struct HashRegionTable
+{
+    OpenRegionTable openRegions;           // hash regions that are still open, keyed by their diagonals
 
     BestRegionArray* pBestCloseRegions;    // an array hold the best hash regions within the closer search region
 
     BestRegionArray* pBestFarRegions;      // an array hold the best hash regions within the further search region
 
+    TouchedArray* pTouched;                // query positions whose best regions have to be cleared for the next query
+
+    BestRegion* pTopRegions[MAX_TOP_REGIONS]; // the longest best regions in 'pBestCloseRegions', longest first; 
+                                              // ties are broken by the smaller query begin
+
+    unsigned int numTopRegions;            // number of regions in 'pTopRegions'
+
+    HashSeedArray* pQuerySeeds;            // minimizers of the query, used only with a minimizer hash table
+
+    SR_HashKeyArray* pQueryKeys;           // all the hash keys of the query
+
+    uint64_t numMaskedSeeds;               // number of query hashes that hit a masked hash since allocation
+
 }HashRegionTable;
 
 
@@ -116,10 +176,43 @@ void HashRegionTableFree(HashRegionTable* pRegionTable);
 //      the best hash region start at each position of the query
 //      will be stored at the 'pBestCloseRegions' and the
 //      'pBestFarRegions' for close query region and far query
-//      region respectively after processing
+//      region respectively after processing. The longest ones of
+//      'pBestCloseRegions' are also kept in 'pTopRegions'.
+//      A hit extends the open region on its diagonal if that region
+//      took a hit at the previous query position.
+//      If the hash table only holds minimizers (windowSize > 1),
+//      only the minimizers of the query are looked up and hits on
+//      the same diagonal that are at most windowSize bases apart
+//      are merged instead; the length of such a region is the span from its
+//      first to its last hit.
+//      Query hashes that are masked in the hash table are skipped
+//      and counted in 'numMaskedSeeds'.
 //==================================================================
 void HashRegionTableLoad(HashRegionTable* pRegionTable, const SR_InHashTable* pHashTable, const SR_QueryRegion* pQueryRegion);
 
+//==================================================================
+// function:
+//      HashRegionTableLoad for a query and for the reverse
+//      complement of the query
+//
+// args:
+//      1. pRegionTable: a pointer to the hash region table of the
+//                       query
+//      2. pRevCompTable: a pointer to the hash region table of the
+//                        reverse complement of the query
+//      3. pHashTable: a pointer to a reference hash table
+//      4. pQueryRegion: a pointer to a query region
+//
+// discussion:
+//      both tables have to be initialized with HashRegionTableInit.
+//      the hash keys of the two strands are rolled in one pass over
+//      the query unless the hash table only holds minimizers. The
+//      best regions are the same as those of HashRegionTableLoad on
+//      each strand
+//==================================================================
+void HashRegionTableLoadBothStrands(HashRegionTable* pRegionTable, HashRegionTable* pRevCompTable, 
+                                   const SR_InHashTable* pHashTable, const SR_QueryRegion* pQueryRegion);
+
 //==========================================================
 // function:
 //      initialize the hash region table for a new query
@@ -145,7 +238,8 @@ void HashRegionTableInit(HashRegionTable* pRegionTable, uint32_t queryLen);
 //      "0" stores the best hash region that starts at query 
 //      position "0". This function will reverse each best 
 //      hash region so that it stores the best hash region 
-//      end instead of begin
+//      end instead of begin. 'pTopRegions' is emptied since
+//      it refers to the start-indexed regions
 //===========================================================
 void HashRegionTableReverseBest(HashRegionTable* pRegionTable);
 
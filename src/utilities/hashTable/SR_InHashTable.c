@@ -17,28 +17,127 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "utilities/common/SR_Error.h"
+#include "utilities/common/SR_Utilities.h"
+#include "SR_Minimizer.h"
 #include "SR_InHashTable.h"
 
+// bits sorted by each pass of the radix sort
+#define RADIX_BITS 16
+
+// hash positions collected before they are sorted into a table
+typedef struct HashPosBuffer
+{
+    uint64_t* keys;
+
+    uint32_t* pos;
+
+    uint32_t size;
+
+    uint32_t capacity;
+
+}HashPosBuffer;
+
+static void PushHashPos(void* pData, uint32_t pos, uint64_t hashKey)
+{
+    HashPosBuffer* pBuffer = (HashPosBuffer*) pData;
+    if (pBuffer->size == pBuffer->capacity)
+    {
+        pBuffer->capacity = pBuffer->capacity == 0 ? 1024 : 2 * pBuffer->capacity;
+        pBuffer->keys = (uint64_t*) realloc(pBuffer->keys, sizeof(uint64_t) * pBuffer->capacity);
+        pBuffer->pos = (uint32_t*) realloc(pBuffer->pos, sizeof(uint32_t) * pBuffer->capacity);
+        if (pBuffer->keys == NULL || pBuffer->pos == NULL)
+            SR_ErrSys("ERROR: Not enough memory for the storage of hash positions.\n");
+    }
+
+    pBuffer->keys[pBuffer->size] = hashKey;
+    pBuffer->pos[pBuffer->size] = pos;
+    ++(pBuffer->size);
+}
+
+// LSD radix sort on the keys; it is stable, so the positions of a key stay in increasing order
+static void SortHashPos(HashPosBuffer* pBuffer, unsigned char hashSize)
+{
+    uint32_t* counts = (uint32_t*) malloc(sizeof(uint32_t) * ((uint32_t) 1 << RADIX_BITS));
+    uint64_t* tempKeys = (uint64_t*) malloc(sizeof(uint64_t) * (pBuffer->size + 1));
+    uint32_t* tempPos = (uint32_t*) malloc(sizeof(uint32_t) * (pBuffer->size + 1));
+    if (counts == NULL || tempKeys == NULL || tempPos == NULL)
+        SR_ErrSys("ERROR: Not enough memory for sorting hash positions.\n");
+
+    const uint32_t radixMask = ((uint32_t) 1 << RADIX_BITS) - 1;
+    for (unsigned int shift = 0; shift < 2 * (unsigned int) hashSize; shift += RADIX_BITS)
+    {
+        memset(counts, 0, sizeof(uint32_t) * ((uint32_t) 1 << RADIX_BITS));
+        for (uint32_t i = 0; i != pBuffer->size; ++i)
+            ++counts[(pBuffer->keys[i] >> shift) & radixMask];
+
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i <= radixMask; ++i)
+        {
+            uint32_t count = counts[i];
+            counts[i] = sum;
+            sum += count;
+        }
+
+        for (uint32_t i = 0; i != pBuffer->size; ++i)
+        {
+            uint32_t dest = counts[(pBuffer->keys[i] >> shift) & radixMask]++;
+            tempKeys[dest] = pBuffer->keys[i];
+            tempPos[dest] = pBuffer->pos[i];
+        }
+
+        SR_SWAP(pBuffer->keys, tempKeys, uint64_t*);
+        SR_SWAP(pBuffer->pos, tempPos, uint32_t*);
+    }
+
+    free(counts);
+    free(tempKeys);
+    free(tempPos);
+}
+
 SR_InHashTable* SR_InHashTableAlloc(unsigned char hashSize)
 {
+    SR_InHashTable* pNewTable = SR_InHashTableAllocSorted(hashSize);
+    if (hashSize <= MAX_HASH_SIZE)
+    {
+        pNewTable->numHashes = (uint32_t) 1 << (2 * hashSize);
+        pNewTable->indices = (uint32_t*) malloc(sizeof(uint32_t) * pNewTable->numHashes);
+        if (pNewTable->indices == NULL)
+            SR_ErrSys("ERROR: Not enough memory for the hash index array in a hash table object.\n");
+    }
+
+    return pNewTable;
+}
+
+SR_InHashTable* SR_InHashTableAllocSorted(unsigned char hashSize)
+{
+    if (hashSize > MAX_LONG_HASH_SIZE)
+        SR_ErrQuit("ERROR: Hash size can not be greater than %d\n", MAX_LONG_HASH_SIZE);
+
     SR_InHashTable* pNewTable = (SR_InHashTable*) malloc(sizeof(SR_InHashTable));
     if (pNewTable == NULL)
         SR_ErrSys("ERROR: Not enough memory for a reference hash table object.\n");
     
     pNewTable->id = 0;
     pNewTable->hashSize = hashSize;
+    pNewTable->windowSize = 1;
 
     pNewTable->highEndMask = GET_HIGH_END_MASK(hashSize);
-    pNewTable->numHashes = (uint32_t) 1 << (2 * hashSize);
-    pNewTable->indices = (uint32_t*) malloc(sizeof(uint32_t) * pNewTable->numHashes);
-    if (pNewTable->indices == NULL)
-        SR_ErrSys("ERROR: Not enough memory for the hash index array in a hash table object.\n");
+
+    // the key directory is built by SR_InHashTableLoad
+    pNewTable->keys = NULL;
+    pNewTable->numHashes = 0;
+    pNewTable->indices = NULL;
 
     pNewTable->numPos = 0;
     pNewTable->hashPos = NULL;
 
+    pNewTable->maskedBits = NULL;
+    pNewTable->numMaskedHashes = 0;
+    pNewTable->numMaskedPos = 0;
+
     return pNewTable;
 }
 
@@ -48,6 +147,8 @@ void SR_InHashTableFree(SR_InHashTable* pHashTable)
     {
         free(pHashTable->hashPos);
         free(pHashTable->indices);
+        free(pHashTable->keys);
+        free(pHashTable->maskedBits);
 
         free(pHashTable);
     }
@@ -134,17 +235,192 @@ SR_Status SR_InHashTableRead(SR_InHashTable* pHashTable, FILE* htInput)
     if (readSize != pHashTable->numPos)
         SR_ErrSys("ERROR: Cannot read the hash positions from the hash table.\n");
 
+    // nothing is masked in a freshly read table
+    SR_InHashTableMask(pHashTable, 0);
+
     return SR_OK;
 }
 
 
-SR_Bool SR_InHashTableSearch(HashPosView* pHashPosView, const SR_InHashTable* pHashTable, uint32_t hashKey)
+void SR_InHashTableLoad(SR_InHashTable* pHashTable, const char* refSeq, uint32_t refLen, int32_t id, unsigned char windowSize)
 {
-    if(hashKey >= pHashTable->numHashes)
+    HashPosBuffer buffer = {NULL, NULL, 0, 0};
+    SR_MinimizerScan(refSeq, refLen, pHashTable->hashSize, windowSize, PushHashPos, &buffer);
+    SortHashPos(&buffer, pHashTable->hashSize);
+
+    // count distinct keys
+    uint32_t numHashes = 0;
+    for (uint32_t i = 0; i != buffer.size; ++i)
+    {
+        if (i == 0 || buffer.keys[i] != buffer.keys[i - 1])
+            ++numHashes;
+    }
+
+    free(pHashTable->keys);
+    free(pHashTable->indices);
+    pHashTable->keys = (uint64_t*) malloc(sizeof(uint64_t) * (numHashes + 1));
+    pHashTable->indices = (uint32_t*) malloc(sizeof(uint32_t) * (numHashes + 1));
+    if (pHashTable->keys == NULL || pHashTable->indices == NULL)
+        SR_ErrSys("ERROR: Not enough memory for the key directory in a hash table object.\n");
+
+    numHashes = 0;
+    for (uint32_t i = 0; i != buffer.size; ++i)
+    {
+        if (i == 0 || buffer.keys[i] != buffer.keys[i - 1])
+        {
+            pHashTable->keys[numHashes] = buffer.keys[i];
+            pHashTable->indices[numHashes] = i;
+            ++numHashes;
+        }
+    }
+
+    pHashTable->id = id;
+    pHashTable->windowSize = windowSize > 1 ? windowSize : 1;
+    pHashTable->numHashes = numHashes;
+    pHashTable->numPos = buffer.size;
+
+    // the positions are already grouped by key
+    free(pHashTable->hashPos);
+    pHashTable->hashPos = buffer.pos;
+    free(buffer.keys);
+}
+
+void SR_InHashTableMask(SR_InHashTable* pHashTable, uint32_t maxOccurrence)
+{
+    free(pHashTable->maskedBits);
+    pHashTable->maskedBits = NULL;
+    pHashTable->numMaskedHashes = 0;
+    pHashTable->numMaskedPos = 0;
+
+    if (maxOccurrence == 0 || pHashTable->numHashes == 0)
+        return;
+
+    // compact the hash positions in place, dropping the positions of masked hashes
+    uint32_t newIndex = 0;
+    for (uint32_t i = 0; i != pHashTable->numHashes; ++i)
+    {
+        uint32_t index = pHashTable->indices[i];
+        uint32_t nextIndex = i == (pHashTable->numHashes - 1) ? pHashTable->numPos : pHashTable->indices[i + 1];
+        uint32_t size = nextIndex - index;
+
+        pHashTable->indices[i] = newIndex;
+        if (size > maxOccurrence)
+        {
+            if (pHashTable->maskedBits == NULL)
+            {
+                pHashTable->maskedBits = (unsigned char*) calloc(pHashTable->numHashes / 8 + 1, sizeof(unsigned char));
+                if (pHashTable->maskedBits == NULL)
+                    SR_ErrSys("ERROR: Not enough memory for the masked hash set in a hash table object.\n");
+            }
+
+            pHashTable->maskedBits[i >> 3] |= (unsigned char) (1 << (i & 7));
+            ++(pHashTable->numMaskedHashes);
+            pHashTable->numMaskedPos += size;
+        }
+        else
+        {
+            memmove(pHashTable->hashPos + newIndex, pHashTable->hashPos + index, sizeof(uint32_t) * size);
+            newIndex += size;
+        }
+    }
+
+    pHashTable->numPos = newIndex;
+}
+
+// find the slot of a hash key in the "indices" array
+static SR_Bool GetHashSlot(uint32_t* pSlot, const SR_InHashTable* pHashTable, uint64_t hashKey)
+{
+    if (pHashTable->keys != NULL)
+    {
+        // binary search in the key directory
+        uint32_t min = 0;
+        uint32_t max = pHashTable->numHashes;
+        while (min < max)
+        {
+            uint32_t mid = min + (max - min) / 2;
+            if (pHashTable->keys[mid] < hashKey)
+                min = mid + 1;
+            else
+                max = mid;
+        }
+
+        if (min == pHashTable->numHashes || pHashTable->keys[min] != hashKey)
+            return FALSE;
+
+        *pSlot = min;
+        return TRUE;
+    }
+
+    if (hashKey >= pHashTable->numHashes)
         SR_ErrSys("ERROR: Invalid hash key.\n");
 
-    uint32_t index = pHashTable->indices[hashKey];
-    uint32_t nextIndex = hashKey == (pHashTable->numHashes - 1) ? pHashTable->numPos : pHashTable->indices[hashKey + 1];
+    *pSlot = (uint32_t) hashKey;
+    return TRUE;
+}
+
+SR_Bool SR_InHashTableSearchRange(HashPosView* pHashPosView, const SR_InHashTable* pHashTable, uint64_t hashKey, uint32_t refBegin, uint32_t refEnd)
+{
+    if (!SR_InHashTableSearch(pHashPosView, pHashTable, hashKey))
+        return FALSE;
+
+    const uint32_t* hashPos = pHashPosView->data;
+    uint32_t size = pHashPosView->size;
+    uint32_t begin = 0;
+    uint32_t end = size;
+
+    if (refEnd < hashPos[0] || refBegin > hashPos[size - 1] || refBegin > refEnd)
+    {
+        end = 0;
+    }
+    else
+    {
+        // binary search for the first position not less than refBegin
+        uint32_t max = size;
+        while (begin < max)
+        {
+            uint32_t mid = begin + (max - begin) / 2;
+            if (hashPos[mid] < refBegin)
+                begin = mid + 1;
+            else
+                max = mid;
+        }
+
+        // and the first position greater than refEnd
+        max = size;
+        end = begin;
+        while (end < max)
+        {
+            uint32_t mid = end + (max - end) / 2;
+            if (hashPos[mid] <= refEnd)
+                end = mid + 1;
+            else
+                max = mid;
+        }
+    }
+
+    pHashPosView->data = hashPos + begin;
+    pHashPosView->size = end > begin ? end - begin : 0;
+
+    return TRUE;
+}
+
+SR_Bool SR_InHashTableIsMasked(const SR_InHashTable* pHashTable, uint64_t hashKey)
+{
+    uint32_t slot = 0;
+    if (pHashTable->maskedBits == NULL || !GetHashSlot(&slot, pHashTable, hashKey))
+        return FALSE;
+
+    return (pHashTable->maskedBits[slot >> 3] >> (slot & 7)) & 1 ? TRUE : FALSE;
+}
+
+SR_Bool SR_InHashTableSearch(HashPosView* pHashPosView, const SR_InHashTable* pHashTable, uint64_t hashKey)
+{
+    uint32_t slot = 0;
+    if (!GetHashSlot(&slot, pHashTable, hashKey))
+        return FALSE;
+
+    uint32_t index = pHashTable->indices[slot];
+    uint32_t nextIndex = slot == (pHashTable->numHashes - 1) ? pHashTable->numPos : pHashTable->indices[slot + 1];
 
     if (index == nextIndex)
         return FALSE;
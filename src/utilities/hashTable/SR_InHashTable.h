@@ -30,7 +30,7 @@
 //===============================
 
 // generate a mask to clear the highest 2 bits in a hash key (the leftmost base pair)
-#define GET_HIGH_END_MASK(hashSize) ((uint32_t) 0xffffffff >> (34 - (2 * (hashSize))))
+#define GET_HIGH_END_MASK(hashSize) (((uint64_t) 1 << (2 * (hashSize) - 2)) - 1)
 
 typedef struct HashPosView
 {
@@ -47,15 +47,28 @@ typedef struct SR_InHashTable
 
     unsigned char hashSize;        // size of hash
 
+    unsigned char windowSize;      // minimizer window; 1 means every hash position is stored
+
     uint32_t* hashPos;             // positions of hashes found in the reference sequence
 
     uint32_t* indices;             // index of a given hash in the "hashPos" array
 
-    uint32_t  highEndMask;         // a mask to clar the highest 2 bits in a hash key
+    uint64_t* keys;                // sorted hash keys that are found in the reference; only used 
+                                   // when hashSize > MAX_HASH_SIZE and then "indices" runs parallel
+                                   // to it. NULL for a dense table whose "indices" is addressed by hash key
+
+    uint64_t  highEndMask;         // a mask to clar the highest 2 bits in a hash key
 
     uint32_t  numPos;              // total number of hash positions found in reference
 
-    uint32_t  numHashes;           // total number of different hashes
+    uint32_t  numHashes;           // total number of different hashes (size of "indices")
+
+    unsigned char* maskedBits;     // bit set over the slots of "indices"; a set bit marks a hash that
+                                   // is masked because it occurs too often. NULL if nothing is masked
+
+    uint32_t  numMaskedHashes;     // number of masked hashes
+
+    uint32_t  numMaskedPos;        // number of hash positions removed by masking
 
 }SR_InHashTable;
 
@@ -64,8 +77,29 @@ typedef struct SR_InHashTable
 // Constructors and Destructors
 //===============================
 
+//================================================================
+// function:
+//      allocate a hash table
+//
+// args:
+//      1. hashSize: size of hash. Up to MAX_HASH_SIZE a dense index
+//                   array of 4^hashSize is allocated; longer hashes
+//                   (up to MAX_LONG_HASH_SIZE) use a sorted key
+//                   directory that is filled by SR_InHashTableLoad
+//================================================================
 SR_InHashTable* SR_InHashTableAlloc(unsigned char hashSize);
 
+//================================================================
+// function:
+//      allocate a hash table that uses a sorted key directory
+//      whatever its hash size, e.g. a table of a small reference
+//      window
+//
+// args:
+//      1. hashSize: size of hash (up to MAX_LONG_HASH_SIZE)
+//================================================================
+SR_InHashTable* SR_InHashTableAllocSorted(unsigned char hashSize);
+
 void SR_InHashTableFree(SR_InHashTable* pHashTable);
 
 
@@ -135,6 +169,38 @@ SR_Status SR_InHashTableJump(FILE* htInput, const SR_RefHeader* pRefHeader, int3
 //==================================================================
 SR_Status SR_InHashTableRead(SR_InHashTable* pHashTable, FILE* htInput);
 
+//==================================================================
+// function:
+//      hash a reference sequence directly into a hash table with
+//      a sorted key directory (hashSize > MAX_HASH_SIZE or a table
+//      from SR_InHashTableAllocSorted)
+//
+// args:
+//      1. pHashTable: a pointer to the hash table structure
+//      2. refSeq: the reference sequence
+//      3. refLen: length of the reference sequence
+//      4. id: id of the reference
+//      5. windowSize: minimizer window; 1 stores every position
+//==================================================================
+void SR_InHashTableLoad(SR_InHashTable* pHashTable, const char* refSeq, uint32_t refLen, int32_t id, unsigned char windowSize);
+
+//==================================================================
+// function:
+//      mask the hashes that occur more than a given number of
+//      times in the reference
+//
+// args:
+//      1. pHashTable: a pointer to the hash table structure
+//      2. maxOccurrence: the occurrence cap; 0 disables masking
+//
+// discussion:
+//      the positions of a masked hash are removed from the table,
+//      so SR_InHashTableSearch finds nothing for it.
+//      SR_InHashTableIsMasked tells a masked hash from a hash that
+//      is absent in the reference
+//==================================================================
+void SR_InHashTableMask(SR_InHashTable* pHashTable, uint32_t maxOccurrence);
+
 //======================================================================
 // function:
 //      get the hash position array of a given hash key
@@ -149,7 +215,38 @@ SR_Status SR_InHashTableRead(SR_InHashTable* pHashTable, FILE* htInput);
 //      structure will be loaded and TRUE will be returned; otherwise
 //      FALSE is returned.
 //======================================================================
-SR_Bool SR_InHashTableSearch(HashPosView* pHashPosView, const SR_InHashTable* pHashTable, uint32_t hashKey);
+SR_Bool SR_InHashTableSearch(HashPosView* pHashPosView, const SR_InHashTable* pHashTable, uint64_t hashKey);
+
+//======================================================================
+// function:
+//      get the hash positions of a given hash key that are within a
+//      reference window
+//
+// args:
+//      1. pHashPosView: a pointer to the hash position view
+//      2. pHashTable: a pointer to the hash table structure
+//      3. hashKey: the hash key
+//      4. refBegin: the first reference position of the window
+//      5. refEnd: the last reference position of the window
+//
+// return:
+//      FALSE if the hash is not found in the reference at all; TRUE
+//      otherwise, even if no position is in the window (size is 0)
+//======================================================================
+SR_Bool SR_InHashTableSearchRange(HashPosView* pHashPosView, const SR_InHashTable* pHashTable, uint64_t hashKey, uint32_t refBegin, uint32_t refEnd);
+
+//======================================================================
+// function:
+//      check if a hash key is masked by SR_InHashTableMask
+//
+// args:
+//      1. pHashTable: a pointer to the hash table structure
+//      2. hashKey: the hash key
+//
+// return:
+//      TRUE if the hash is masked, FALSE otherwise
+//======================================================================
+SR_Bool SR_InHashTableIsMasked(const SR_InHashTable* pHashTable, uint64_t hashKey);
 
 
 #endif  /*SR_INHASHTABLE_H*/
@@ -0,0 +1,194 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SR_KmerFilter.c
+ *
+ *    Description:  presence filter of the hashes of a reference
+ *
+ *        Version:  1.0
+ *        Created:  10/19/2026
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ * =====================================================================================
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "utilities/common/SR_Error.h"
+#include "SR_BaseEncoder.h"
+#include "SR_KmerFilter.h"
+
+// bits probed for a hash in a Bloom filter
+#define BLOOM_PROBES 3
+
+// the smallest Bloom filter
+#define MIN_BLOOM_BITS ((uint64_t) 1 << 16)
+
+// mix the bits of a hash key (the finalizer of splitmix64)
+static inline uint64_t MixHashKey(uint64_t hashKey)
+{
+    hashKey ^= hashKey >> 30;
+    hashKey *= 0xbf58476d1ce4e5b9ULL;
+    hashKey ^= hashKey >> 27;
+    hashKey *= 0x94d049bb133111ebULL;
+    hashKey ^= hashKey >> 31;
+
+    return hashKey;
+}
+
+// the bit of the i-th probe of a hash key; the probes step by an odd number
+static inline uint64_t GetProbeBit(const SR_KmerFilter* pKmerFilter, uint64_t mixed, unsigned int i)
+{
+    if (pKmerFilter->numProbes == 0)
+        return mixed;
+
+    return (mixed + i * ((mixed >> 32) | 1)) & (pKmerFilter->numBits - 1);
+}
+
+static void EncodeSequence(SR_KmerFilter* pKmerFilter, const char* seq, uint32_t seqLen)
+{
+    if (pKmerFilter->codeCapacity < seqLen)
+    {
+        free(pKmerFilter->codes);
+        pKmerFilter->codeCapacity = 2 * seqLen;
+        pKmerFilter->codes = (unsigned char*) malloc(pKmerFilter->codeCapacity);
+        if (pKmerFilter->codes == NULL)
+            SR_ErrSys("ERROR: Not enough memory for the codes in a kmer filter object.\n");
+    }
+
+    SR_EncodeBases(pKmerFilter->codes, seq, seqLen);
+}
+
+
+//===============================
+// Constructors and Destructors
+//===============================
+
+SR_KmerFilter* SR_KmerFilterAlloc(void)
+{
+    SR_KmerFilter* pNewFilter = (SR_KmerFilter*) calloc(1, sizeof(SR_KmerFilter));
+    if (pNewFilter == NULL)
+        SR_ErrSys("ERROR: Not enough memory for a kmer filter object.\n");
+
+    return pNewFilter;
+}
+
+void SR_KmerFilterFree(SR_KmerFilter* pKmerFilter)
+{
+    if (pKmerFilter != NULL)
+    {
+        free(pKmerFilter->bits);
+        free(pKmerFilter->codes);
+
+        free(pKmerFilter);
+    }
+}
+
+
+//===============================
+// Interface functions
+//===============================
+
+void SR_KmerFilterLoad(SR_KmerFilter* pKmerFilter, const char* seq, uint32_t seqLen, unsigned char hashSize)
+{
+    SR_KmerFilterClear(pKmerFilter);
+    pKmerFilter->hashSize = hashSize;
+
+    if (hashSize <= MAX_DIRECT_FILTER_HASH_SIZE)
+    {
+        pKmerFilter->numBits = (uint64_t) 1 << (2 * hashSize);
+        pKmerFilter->numProbes = 0;
+    }
+    else
+    {
+        pKmerFilter->numBits = MIN_BLOOM_BITS;
+        while (pKmerFilter->numBits < 16 * (uint64_t) seqLen)
+            pKmerFilter->numBits <<= 1;
+
+        pKmerFilter->numProbes = BLOOM_PROBES;
+    }
+
+    pKmerFilter->bits = (uint64_t*) calloc(pKmerFilter->numBits / 64 + 1, sizeof(uint64_t));
+    if (pKmerFilter->bits == NULL)
+        SR_ErrSys("ERROR: Not enough memory for the bits of a kmer filter object.\n");
+
+    EncodeSequence(pKmerFilter, seq, seqLen);
+
+    // roll the key over the codes; an invalid base restarts it
+    const unsigned char* codes = pKmerFilter->codes;
+    const uint64_t mask = ((uint64_t) 1 << (2 * hashSize)) - 1;
+    const unsigned int numProbes = pKmerFilter->numProbes > 0 ? pKmerFilter->numProbes : 1;
+    uint64_t hashKey = 0;
+    uint32_t validBases = 0;
+    for (uint32_t i = 0; i != seqLen; ++i)
+    {
+        if (codes[i] == INVALID_BASE_CODE)
+        {
+            validBases = 0;
+            hashKey = 0;
+            continue;
+        }
+
+        hashKey = (hashKey << 2 | codes[i]) & mask;
+        if (++validBases >= hashSize)
+        {
+            uint64_t mixed = pKmerFilter->numProbes > 0 ? MixHashKey(hashKey) : hashKey;
+            for (unsigned int p = 0; p != numProbes; ++p)
+            {
+                uint64_t bit = GetProbeBit(pKmerFilter, mixed, p);
+                pKmerFilter->bits[bit >> 6] |= (uint64_t) 1 << (bit & 63);
+            }
+        }
+    }
+}
+
+void SR_KmerFilterClear(SR_KmerFilter* pKmerFilter)
+{
+    free(pKmerFilter->bits);
+    pKmerFilter->bits = NULL;
+    pKmerFilter->numBits = 0;
+}
+
+SR_Bool SR_KmerFilterMayContain(SR_KmerFilter* pKmerFilter, const char* seq, uint32_t seqLen)
+{
+    if (pKmerFilter->numBits == 0)
+        return TRUE;
+
+    EncodeSequence(pKmerFilter, seq, seqLen);
+
+    const unsigned char* codes = pKmerFilter->codes;
+    const unsigned char hashSize = pKmerFilter->hashSize;
+    const uint64_t mask = ((uint64_t) 1 << (2 * hashSize)) - 1;
+    const unsigned int numProbes = pKmerFilter->numProbes > 0 ? pKmerFilter->numProbes : 1;
+    uint64_t hashKey = 0;
+    uint32_t validBases = 0;
+    for (uint32_t i = 0; i != seqLen; ++i)
+    {
+        if (codes[i] == INVALID_BASE_CODE)
+        {
+            validBases = 0;
+            hashKey = 0;
+            continue;
+        }
+
+        hashKey = (hashKey << 2 | codes[i]) & mask;
+        if (++validBases >= hashSize)
+        {
+            uint64_t mixed = pKmerFilter->numProbes > 0 ? MixHashKey(hashKey) : hashKey;
+            unsigned int p = 0;
+            for (; p != numProbes; ++p)
+            {
+                uint64_t bit = GetProbeBit(pKmerFilter, mixed, p);
+                if (((pKmerFilter->bits[bit >> 6] >> (bit & 63)) & 1) == 0)
+                    break;
+            }
+
+            if (p == numProbes)
+                return TRUE;
+        }
+    }
+
+    return FALSE;
+}
@@ -0,0 +1,95 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SR_KmerFilter.h
+ *
+ *    Description:  presence filter of the hashes of a reference
+ *
+ *        Version:  1.0
+ *        Created:  10/19/2026
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ * =====================================================================================
+ */
+#ifndef  SR_KMERFILTER_H
+#define  SR_KMERFILTER_H
+
+#include <stdint.h>
+
+#include "utilities/common/SR_Types.h"
+
+//===============================
+// Type and constant definition
+//===============================
+
+// hash sizes up to this get a bit for every hash key
+#define MAX_DIRECT_FILTER_HASH_SIZE 12
+
+// an object tells whether a sequence may share a hash with a reference
+typedef struct SR_KmerFilter
+{
+    uint64_t* bits;            // a bit for every hash key, or a Bloom filter
+
+    uint64_t numBits;          // number of bits; a power of 2. 0 if not loaded
+
+    unsigned char hashSize;    // size of the hashes
+
+    unsigned char numProbes;   // bits probed for a hash; 0 for a bit per hash key
+
+    unsigned char* codes;      // 2-bit codes of the last sequence
+
+    uint32_t codeCapacity;     // capacity of "codes"
+
+}SR_KmerFilter;
+
+
+//===============================
+// Constructors and Destructors
+//===============================
+
+SR_KmerFilter* SR_KmerFilterAlloc(void);
+
+void SR_KmerFilterFree(SR_KmerFilter* pKmerFilter);
+
+
+//===============================
+// Interface functions
+//===============================
+
+//=====================================================================
+// function:
+//      set the filter to all the hashes of a reference
+//
+// args:
+//      1. pKmerFilter: a pointer to a kmer filter object
+//      2. seq: the reference sequence
+//      3. seqLen: length of the reference
+//      4. hashSize: size of hash (up to MAX_LONG_HASH_SIZE)
+//
+// discussion:
+//      hashes are encoded as SR_HashKeyArrayLoad does, so hashes with
+//      an invalid base are left out. Up to MAX_DIRECT_FILTER_HASH_SIZE
+//      every hash key has its own bit; larger hashes go into a Bloom
+//      filter of about 16 bits per hash
+//=====================================================================
+void SR_KmerFilterLoad(SR_KmerFilter* pKmerFilter, const char* seq, uint32_t seqLen, unsigned char hashSize);
+
+//=====================================================================
+// function:
+//      drop the hashes of the filter
+//=====================================================================
+void SR_KmerFilterClear(SR_KmerFilter* pKmerFilter);
+
+//=====================================================================
+// function:
+//      check if a sequence may share a hash with the reference
+//
+// return:
+//      FALSE if none of the hashes of the sequence is in the reference;
+//      TRUE otherwise or if the filter is not loaded. a Bloom filter
+//      may give TRUE for a sequence sharing no hash
+//=====================================================================
+SR_Bool SR_KmerFilterMayContain(SR_KmerFilter* pKmerFilter, const char* seq, uint32_t seqLen);
+
+#endif  /*SR_KMERFILTER_H*/
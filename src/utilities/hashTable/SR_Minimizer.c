@@ -0,0 +1,159 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SR_Minimizer.c
+ *
+ *    Description:  (w,k)-minimizer sampling of hash positions
+ *
+ *        Version:  1.0
+ *        Created:  10/19/2026
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ * =====================================================================================
+ */
+
+#include <stdint.h>
+
+#include "utilities/common/SR_Types.h"
+#include "SR_BaseEncoder.h"
+#include "SR_Minimizer.h"
+
+// number of bases encoded at a time
+#define ENCODE_BLOCK_SIZE 4096
+
+// a hash in the current window
+typedef struct MinimizerEntry
+{
+    uint64_t order;     // scrambled key, the smallest one is the minimizer
+
+    uint64_t hashKey;   // 2-bit packed hash key
+
+    uint32_t pos;       // position of the hash
+
+}MinimizerEntry;
+
+// invertible integer hash restricted to the key bits,
+// so that poly-A hashes are not always the minimizers
+static inline uint64_t ScrambleKey(uint64_t key, uint64_t mask)
+{
+    key = (~key + (key << 21)) & mask;
+    key = key ^ key >> 24;
+    key = ((key + (key << 3)) + (key << 8)) & mask;
+    key = key ^ key >> 14;
+    key = ((key + (key << 2)) + (key << 4)) & mask;
+    key = key ^ key >> 28;
+    key = (key + (key << 31)) & mask;
+
+    return key;
+}
+
+// index (in the ring) of the leftmost smallest entry
+static unsigned int FindMinimum(const MinimizerEntry* ring, unsigned int first, unsigned int count, unsigned int windowSize)
+{
+    unsigned int best = first;
+    for (unsigned int i = 1; i < count; ++i)
+    {
+        unsigned int curr = (first + i) % windowSize;
+        if (ring[curr].order < ring[best].order)
+            best = curr;
+    }
+
+    return best;
+}
+
+void SR_MinimizerScan(const char* seq, uint32_t seqLen, unsigned char hashSize, unsigned char windowSize, SR_MinimizerFunc func, void* pData)
+{
+    unsigned char codes[ENCODE_BLOCK_SIZE];
+
+    if (windowSize == 0)
+        windowSize = 1;
+
+    const uint64_t mask = ((uint64_t) 1 << (2 * hashSize)) - 1;
+
+    MinimizerEntry ring[MAX_MINIMIZER_WINDOW];
+    unsigned int first = 0;         // the oldest entry in the ring
+    unsigned int count = 0;         // number of entries in the ring
+    unsigned int minIndex = 0;      // the current minimizer in the ring
+    SR_Bool hasReported = FALSE;    // is the current minimizer reported
+    uint64_t hashKey = 0;
+    unsigned int validBases = 0;    // number of consecutive valid bases
+
+    for (uint32_t i = 0; i <= seqLen; ++i)
+    {
+        if (i % ENCODE_BLOCK_SIZE == 0 && i < seqLen)
+        {
+            uint32_t blockLen = seqLen - i < ENCODE_BLOCK_SIZE ? seqLen - i : ENCODE_BLOCK_SIZE;
+            SR_EncodeBases(codes, seq + i, blockLen);
+        }
+
+        unsigned char tValue = i < seqLen ? codes[i % ENCODE_BLOCK_SIZE] : INVALID_BASE_CODE;
+        if (tValue == INVALID_BASE_CODE)
+        {
+            // a stretch too short for a complete window still reports its minimum
+            if (count > 0 && count < windowSize)
+            {
+                minIndex = FindMinimum(ring, first, count, windowSize);
+                func(pData, ring[minIndex].pos, ring[minIndex].hashKey);
+            }
+
+            count = 0;
+            first = 0;
+            hasReported = FALSE;
+            validBases = 0;
+            hashKey = 0;
+            continue;
+        }
+
+        hashKey = (hashKey << 2 | tValue) & mask;
+        if (++validBases < hashSize)
+            continue;
+
+        // every hash is a minimizer of a window of 1
+        if (windowSize == 1)
+        {
+            func(pData, i + 1 - hashSize, hashKey);
+            continue;
+        }
+
+        // push the new hash into the window
+        unsigned int newIndex;
+        if (count < windowSize)
+        {
+            newIndex = (first + count) % windowSize;
+            ++count;
+        }
+        else
+        {
+            newIndex = first;
+            first = (first + 1) % windowSize;
+        }
+
+        ring[newIndex].order = ScrambleKey(hashKey, mask);
+        ring[newIndex].pos = i + 1 - hashSize;
+        ring[newIndex].hashKey = hashKey;
+
+        if (count == 1)
+        {
+            minIndex = newIndex;
+            hasReported = FALSE;
+        }
+        else if (newIndex == minIndex)
+        {
+            // the minimizer just left the window
+            minIndex = FindMinimum(ring, first, count, windowSize);
+            hasReported = FALSE;
+        }
+        else if (ring[newIndex].order < ring[minIndex].order)
+        {
+            minIndex = newIndex;
+            hasReported = FALSE;
+        }
+
+        if (count == windowSize && !hasReported)
+        {
+            func(pData, ring[minIndex].pos, ring[minIndex].hashKey);
+            hasReported = TRUE;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  SR_Minimizer.h
+ *
+ *    Description:  (w,k)-minimizer sampling of hash positions
+ *
+ *        Version:  1.0
+ *        Created:  10/19/2026
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ * =====================================================================================
+ */
+#ifndef  SR_MINIMIZER_H
+#define  SR_MINIMIZER_H
+
+#include <stdint.h>
+
+//===============================
+// Type and constant definition
+//===============================
+
+// the largest supported minimizer window
+#define MAX_MINIMIZER_WINDOW 255
+
+// called once for each selected hash: its position and its hash key
+typedef void (*SR_MinimizerFunc)(void* pData, uint32_t pos, uint64_t hashKey);
+
+
+//===============================
+// Interface functions
+//===============================
+
+//=====================================================================
+// function:
+//      scan a sequence and report its (w,k)-minimizers, i.e. among
+//      every "windowSize" consecutive hashes (of "hashSize" bases)
+//      the one with the smallest scrambled key
+//
+// args:
+//      1. seq: the sequence (upper or lower case; other letters
+//              than ACGT break the hashes)
+//      2. seqLen: length of the sequence
+//      3. hashSize: size of hash (up to MAX_LONG_HASH_SIZE)
+//      4. windowSize: number of consecutive hashes in a window;
+//                     1 reports every hash
+//      5. func: callback receiving each minimizer
+//      6. pData: passed to func untouched
+//
+// discussion:
+//      minimizers are reported in increasing position order and each
+//      position at most once. The leftmost smallest hash of a window is
+//      chosen, so identical substrings of at least
+//      windowSize + hashSize - 1 bases pick identical minimizers in the
+//      reference and in reads. A stretch between two invalid bases that
+//      is too short for a full window still reports its smallest hash.
+//=====================================================================
+void SR_MinimizerScan(const char* seq, uint32_t seqLen, unsigned char hashSize, unsigned char windowSize, SR_MinimizerFunc func, void* pData);
+
+#endif  /*SR_MINIMIZER_H*/
@@ -19,54 +19,24 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
-#include <ctype.h>
 
 #include "utilities/common/SR_Utilities.h"
+#include "SR_BaseEncoder.h"
+#include "SR_Minimizer.h"
 #include "SR_OutHashTable.h"
 
 #define DEFAULT_HASH_SIZE 7
 #define DEFAULT_POS_ARR_CAPACITY 2000
 
-// calculate the hash key for a hash in a read that starts at a certain position
-static SR_Bool GetNextHashKey(uint32_t* hashKey, uint32_t* pos, const char* query, uint32_t queryLen, uint32_t mask, unsigned char hashSize)
-{
-    // table use to translate a nucleotide into its corresponding 2-bit representation
-    static const char translation[26] = { 0, -1, 1, -1, -1, -1, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 3, -1, -1, -1, -1, -1, -1 };
-
-    unsigned int endPos = *pos + hashSize;
-    unsigned int startPos = *pos == 0 ? *pos : endPos - 1;
-
-
-    while (endPos <= queryLen)
-    {
-        // remove the highest 2 bits in the previous hash key
-        *hashKey &= mask;
-
-        char tValue = 0;
-        for (unsigned int i = startPos; i != endPos; ++i)
-        {
-            char cur_base = 0;
-            if (islower(query[i])) cur_base = toupper(query[i]);
-            else cur_base = query[i];
-            tValue = translation[cur_base - 'A'];
-            if (tValue < 0)
-            {
-                *hashKey = 0;
-
-                *pos = i + 1;
-                startPos = *pos;
-                endPos = startPos + hashSize;
-                break;
-            }
-
-            *hashKey = *hashKey << 2 | tValue;
-        }
-
-        if (tValue >= 0)
-            return TRUE;
-    }
+// number of hashes whose keys are generated at a time
+#define HASH_KEY_BLOCK_SIZE 65536
 
-    return FALSE;
+// store a minimizer found by SR_MinimizerScan
+static void PushMinimizer(void* pData, uint32_t pos, uint64_t hashKey)
+{
+    SR_OutHashTable* pHashTable = (SR_OutHashTable*) pData;
+    SR_HashPosArrayPushBack(&((pHashTable->hashPosTable)[hashKey]), pos);
+    ++(pHashTable->numPos);
 }
 
 
@@ -144,6 +114,7 @@ SR_OutHashTable* SR_OutHashTableAlloc(unsigned char hashSize)
     
     newTable->id = 0;
     newTable->hashSize = hashSize;
+    newTable->windowSize = 1;
     newTable->numPos = 0;
     newTable->numHashes = (uint32_t) 1 << (2 * hashSize);
 
@@ -175,17 +146,38 @@ void SR_OutHashTableFree(SR_OutHashTable* pHashTable)
 
 void SR_OutHashTableLoad(SR_OutHashTable* pHashTable, const char* refSeq, uint32_t refLen, int32_t id)
 {
-    uint32_t mask = GetHighEndMask(pHashTable->hashSize);
-    uint32_t hashKey = 0;
-    uint32_t pos = 0;
-
     pHashTable->id = id;
-    while (GetNextHashKey(&hashKey, &pos, refSeq, refLen, mask, pHashTable->hashSize))
+
+    // the reference is hashed block by block; consecutive blocks overlap by
+    // hashSize - 1 bases so that each hash is generated in exactly one block
+    SR_HashKeyArray* pHashKeys = SR_HashKeyArrayAlloc();
+    for (uint32_t blockBegin = 0; blockBegin < refLen; blockBegin += HASH_KEY_BLOCK_SIZE)
     {
-        SR_HashPosArrayPushBack(&((pHashTable->hashPosTable)[hashKey]), pos);
-        ++(pHashTable->numPos);
-        ++pos;
+        uint32_t blockLen = refLen - blockBegin;
+        if (blockLen > HASH_KEY_BLOCK_SIZE + pHashTable->hashSize - 1)
+            blockLen = HASH_KEY_BLOCK_SIZE + pHashTable->hashSize - 1;
+
+        SR_HashKeyArrayLoad(pHashKeys, refSeq + blockBegin, blockLen, pHashTable->hashSize);
+        for (uint32_t i = 0; i != pHashKeys->size; ++i)
+            SR_HashPosArrayPushBack(&((pHashTable->hashPosTable)[pHashKeys->keys[i]]), blockBegin + pHashKeys->pos[i]);
+
+        pHashTable->numPos += pHashKeys->size;
     }
+
+    SR_HashKeyArrayFree(pHashKeys);
+}
+
+void SR_OutHashTableLoadMinimizers(SR_OutHashTable* pHashTable, const char* refSeq, uint32_t refLen, int32_t id, unsigned char windowSize)
+{
+    if (windowSize <= 1)
+    {
+        SR_OutHashTableLoad(pHashTable, refSeq, refLen, id);
+        return;
+    }
+
+    pHashTable->id = id;
+    pHashTable->windowSize = windowSize;
+    SR_MinimizerScan(refSeq, refLen, pHashTable->hashSize, windowSize, PushMinimizer, pHashTable);
 }
 
 int64_t SR_OutHashTableWrite(const SR_OutHashTable* pHashTable, FILE* htOutput)
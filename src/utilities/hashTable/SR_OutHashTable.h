@@ -46,6 +46,8 @@ typedef struct SR_OutHashTable
     
     unsigned char hashSize;      // size of hash
 
+    unsigned char windowSize;    // minimizer window; 1 means every hash position is stored
+
     SR_HashPosArray* hashPosTable;  // table holds all the position of hashes found in reference
 
     uint32_t  numPos;            // total number of hash positions found in reference
@@ -71,6 +73,9 @@ void SR_OutHashTableFree(SR_OutHashTable* pHashTable);
 
 void SR_OutHashTableLoad(SR_OutHashTable* pHashTable, const char* refSeq, uint32_t refLen, int32_t id);
 
+// only store the positions of the (windowSize, hashSize)-minimizers of the reference
+void SR_OutHashTableLoadMinimizers(SR_OutHashTable* pHashTable, const char* refSeq, uint32_t refLen, int32_t id, unsigned char windowSize);
+
 
 int64_t SR_OutHashTableWrite(const SR_OutHashTable* pHashTable, FILE* htOutput);
 
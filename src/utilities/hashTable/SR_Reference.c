@@ -175,6 +175,7 @@ SR_Reference* SR_ReferenceAlloc(void)
     newRef->id = 0;
     newRef->seqLen = 0;
     newRef->seqCap = DEFAULT_REF_CAP;
+    newRef->seqBegin = 0;
 
     return newRef;
 }
@@ -92,6 +92,8 @@ typedef struct SR_Reference
 
     uint32_t seqCap;              // capacity of reference sequence
 
+    uint32_t seqBegin;            // chromosome position of sequence[0]; non-zero when only a slice is loaded
+
 }SR_Reference;
 
 // an object holds the pointer to an existed reference
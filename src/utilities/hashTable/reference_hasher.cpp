@@ -18,6 +18,8 @@ ReferenceHasher::ReferenceHasher(void)
     : references_(NULL)
     , hash_table_(NULL)
     , hash_size_(7)
+    , window_size_(1)
+    , max_occurrence_(0)
     , is_loaded_(false){
   Init();
 }
@@ -26,6 +28,8 @@ ReferenceHasher::ReferenceHasher(const char* sequence)
     : references_(NULL)
     , hash_table_(NULL)
     , hash_size_(7)
+    , window_size_(1)
+    , max_occurrence_(0)
     , is_loaded_(false){
   Init();
   SetSequence(sequence);
@@ -46,15 +50,17 @@ void ReferenceHasher::Init(void) {
   references_->id       = 0;
   references_->seqLen   = 0;
   references_->seqCap   = 0;
+  references_->seqBegin = 0;
 }
 
-bool ReferenceHasher::SetSequence(const char* sequence) {
+bool ReferenceHasher::SetSequence(const char* sequence, const uint32_t& begin) {
   if (is_loaded_) {
     fprintf(stderr, "WARNING: Please use Clear before setting the new sequence.\n");
     return false;
   }
   references_->sequence = (char*)sequence;
   references_->seqLen   = strlen(sequence);
+  references_->seqBegin = begin;
 
   return true;
 }
@@ -80,14 +86,20 @@ bool ReferenceHasher::Load(void) {
 
   // index every possible hash position in the current chromosome
   // and write the results into hash position index file and hash position file
-  SR_OutHashTable* out_hash_table = SR_OutHashTableAlloc(hash_size_);
-  SR_OutHashTableLoad(out_hash_table, references_->sequence, 
-                      references_->seqLen, references_->id);
-
   hash_table_ = SR_InHashTableAlloc(hash_size_);
-  ConvertHashTableOutToIn(out_hash_table, hash_table_);
+  if (hash_size_ > MAX_HASH_SIZE) {
+    // long hashes are sorted into a key directory instead of a dense table
+    SR_InHashTableLoad(hash_table_, references_->sequence, 
+                       references_->seqLen, references_->id, window_size_);
+  } else {
+    SR_OutHashTable* out_hash_table = SR_OutHashTableAlloc(hash_size_);
+    SR_OutHashTableLoadMinimizers(out_hash_table, references_->sequence, 
+                                  references_->seqLen, references_->id, window_size_);
+    ConvertHashTableOutToIn(out_hash_table, hash_table_);
+    SR_OutHashTableFree(out_hash_table);
+  }
 
-  SR_OutHashTableFree(out_hash_table);
+  if (max_occurrence_ > 0) SR_InHashTableMask(hash_table_, max_occurrence_);
 
   is_loaded_ = true;
   return true;
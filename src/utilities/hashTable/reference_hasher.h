@@ -18,14 +18,29 @@ class ReferenceHasher {
   //            If the filename is already given in the constructor,
   //            then you don't have to use this function.
   // @param:    fasta: fasta filename
-  bool SetSequence(const char* fasta);
+  // @param:    begin: chromosome position of the first base when the
+  //                   sequence is only a slice of the chromosome.
+  //                   Hashed positions stay relative to the sequence.
+  bool SetSequence(const char* fasta, const uint32_t& begin = 0);
 
   // @function: Setting hash size.
   //            Notice that 1) Default hash size is 7; 
-  //            2) before Load(), the hash size should be set.
+  //            2) before Load(), the hash size should be set;
+  //            3) sizes above MAX_HASH_SIZE (up to MAX_LONG_HASH_SIZE)
+  //            are kept in a sorted key directory.
   //            The size also can be given in the constructor.
   void SetHashSize(const int& hash_size) {hash_size_ = hash_size;};
 
+  // @function: Setting the minimizer window.
+  //            With a window w > 1, only the (w, hash_size)-minimizers
+  //            are indexed. Default is 1, i.e. every hash position.
+  void SetWindowSize(const int& window_size) {window_size_ = window_size;};
+
+  // @function: Setting the occurrence cap of hashes.
+  //            Hashes occurring more than max_occurrence times are
+  //            masked out of the table. Default is 0, i.e. no masking.
+  void SetMaxOccurrence(const int& max_occurrence) {max_occurrence_ = max_occurrence;};
+
   // @function: Loading special references from the fasta file 
   //            and hashing them.
   bool Load(void);
@@ -42,6 +57,8 @@ class ReferenceHasher {
   SR_Reference* references_;
   SR_InHashTable* hash_table_;
   int hash_size_;
+  int window_size_;
+  int max_occurrence_;
   bool is_loaded_;
 
   void Init(void);
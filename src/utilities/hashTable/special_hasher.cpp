@@ -19,6 +19,8 @@ SpecialHasher::SpecialHasher(void)
     , references_(NULL)
     , hash_table_(NULL)
     , hash_size_(7)
+    , window_size_(1)
+    , max_occurrence_(0)
     , is_loaded_(false)
     , ref_id_start_no_(0){
   Init();
@@ -30,6 +32,8 @@ SpecialHasher::SpecialHasher(const char* fasta, const int& hash_size, const int&
     , references_(NULL)
     , hash_table_(NULL)
     , hash_size_(hash_size)
+    , window_size_(1)
+    , max_occurrence_(0)
     , is_loaded_(false)
     , ref_id_start_no_(ref_id_start_no){
   Init();
@@ -72,14 +76,20 @@ bool SpecialHasher::Load(void) {
 
   // index every possible hash position in the current chromosome
   // and write the results into hash position index file and hash position file
-  SR_OutHashTable* out_hash_table = SR_OutHashTableAlloc(hash_size_);
-  SR_OutHashTableLoad(out_hash_table, references_->sequence, 
-                      references_->seqLen, references_->id);
-
   hash_table_ = SR_InHashTableAlloc(hash_size_);
-  ConvertHashTableOutToIn(out_hash_table, hash_table_);
+  if (hash_size_ > MAX_HASH_SIZE) {
+    // long hashes are sorted into a key directory instead of a dense table
+    SR_InHashTableLoad(hash_table_, references_->sequence, 
+                       references_->seqLen, references_->id, window_size_);
+  } else {
+    SR_OutHashTable* out_hash_table = SR_OutHashTableAlloc(hash_size_);
+    SR_OutHashTableLoadMinimizers(out_hash_table, references_->sequence, 
+                                  references_->seqLen, references_->id, window_size_);
+    ConvertHashTableOutToIn(out_hash_table, hash_table_);
+    SR_OutHashTableFree(out_hash_table);
+  }
 
-  SR_OutHashTableFree(out_hash_table);
+  if (max_occurrence_ > 0) SR_InHashTableMask(hash_table_, max_occurrence_);
 
   reference_header_->pSpecialRefInfo->ref_id_start_no = ref_id_start_no_;
 
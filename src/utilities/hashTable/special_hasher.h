@@ -26,12 +26,29 @@ class SpecialHasher {
 
   // @function: Setting hash size.
   //            Notice that 1) Default hash size is 7; 
-  //            2) after Load(), the hash size cannot be reset.
+  //            2) after Load(), the hash size cannot be reset;
+  //            3) sizes above MAX_HASH_SIZE (up to MAX_LONG_HASH_SIZE)
+  //            are kept in a sorted key directory.
   //            The size also can be given in the constructor.
   void SetHashSize(const int& hash_size) {
     if (!is_loaded_) hash_size_ = hash_size;
   };
 
+  // @function: Setting the minimizer window.
+  //            With a window w > 1, only the (w, hash_size)-minimizers
+  //            are indexed, which shrinks the table about (w+1)/2 times.
+  //            Default is 1, i.e. every hash position is indexed.
+  void SetWindowSize(const int& window_size) {
+    if (!is_loaded_) window_size_ = window_size;
+  };
+
+  // @function: Setting the occurrence cap of hashes.
+  //            Hashes occurring more than max_occurrence times are
+  //            masked out of the table. Default is 0, i.e. no masking.
+  void SetMaxOccurrence(const int& max_occurrence) {
+    if (!is_loaded_) max_occurrence_ = max_occurrence;
+  };
+
   // @function: Setting the start number of special references.
   //            Since special references are attached after the original references
   //            in the bam header, the start number of special references is 
@@ -56,6 +73,8 @@ class SpecialHasher {
   SR_Reference* references_;
   SR_InHashTable* hash_table_;
   int hash_size_;
+  int window_size_;
+  int max_occurrence_;
   bool is_loaded_;
   int ref_id_start_no_;
 
@@ -1,7 +1,10 @@
 #include "aligner.h"
 
 #include <assert.h>
+#include <limits.h>
+#include <algorithm>
 #include <list>
+#include <sstream>
 
 #include "dataStructures/target_event.h"
 #include "dataStructures/target_region.h"
@@ -11,6 +14,7 @@
 #include "utilities/miscellaneous/alignment_filter.h"
 #include "utilities/miscellaneous/alignment_collection.h"
 #include "utilities/miscellaneous/hashes_collection.h"
+#include "utilities/miscellaneous/ungapped_extension.h"
 
 namespace Scissors {
 namespace {
@@ -20,6 +24,9 @@ const Scissors::TargetEvent kSpecialInsertion(true, false, false, false);
 const Scissors::TargetEvent kSpecialInvertedInsertion(false, true, false, false);
 const Scissors::TargetEvent kInsertion(false, false, false, true);
 
+// Hash size of the local window tables when no reference hash table is given
+const int kDefaultLocalHashSize = 7;
+
 
 void SetTargetSequence(const SearchRegionType::RegionType& region_type, 
                        SR_QueryRegion* query_region) {
@@ -48,6 +55,34 @@ void SetTargetSequence(const SearchRegionType::RegionType& region_type,
   
 }
 
+// Gets the orphan sequence of query_region as region_type without setting it.
+const char* GetTargetSequence(const SearchRegionType::RegionType& region_type,
+                              const SR_QueryRegion& query_region) {
+  if (region_type.sequence_inverse && region_type.sequence_complement)
+    return query_region.orphanSeqReverseComplament;
+  else if (region_type.sequence_inverse)
+    return query_region.orphanSeqReverse;
+  else if (region_type.sequence_complement)
+    return query_region.orphanSeqComplement;
+  else
+    return query_region.orphanSeqForward;
+}
+
+// Sets the key of the search memo for the orphan in query_region_ that is
+//  searched in [begin, end] of ref_id as region_type.
+void SetSearchKey(const SearchMemo::Search& search,
+                  const SearchRegionType::RegionType& region_type,
+                  const int32_t& ref_id, const int& begin, const int& end,
+                  const string& read_seq, SearchMemo::Key* key) {
+  key->search              = search;
+  key->sequence_inverse    = region_type.sequence_inverse;
+  key->sequence_complement = region_type.sequence_complement;
+  key->ref_id              = ref_id;
+  key->begin               = begin;
+  key->end                 = end;
+  key->sequence            = read_seq;
+}
+
 void AdjustAnchorInfo(const bam1_t& partial, bam1_t* anchor) {
   namespace Constant = BamFlagConstant;
   const bool partial_reverse = partial.core.flag & Constant::kBamFReverse;
@@ -195,6 +230,94 @@ void StoreAlignment(
   }
 }
 
+// Aligns the translated read to the sequence of junction without gaps,
+//  scoring bases as SSW scores them, and sets al as the alignment to the
+//  reference that has the event of junction. Only the given diagonals on
+//  which the read has min_flank bases before the breakpoint, and after it
+//  for deletions, are searched, as others cannot pass the flank filter.
+// @return False if the best ungapped alignment does not cross the breakpoint.
+bool AlignJunction(const vector<int8_t>& read,
+                   const JunctionCache::Junction& junction,
+                   const vector<int>& diagonals,
+                   const int& match, const int& mismatch, const int& min_flank,
+                   StripedSmithWaterman::Alignment* al) {
+  const int read_length = read.size();
+  const int junction_length = junction.translated.size();
+  const int8_t* ref = &junction.translated[0];
+  const int left     = junction.position - junction.begin;
+  const int inserted = junction.insertion ? junction.length : 0;
+  const int deleted  = junction.insertion ? 0 : junction.length;
+  const int right_flank = junction.insertion ? 1 : min_flank;
+
+  // The best segment of each diagonal; ref base j + diagonal pairs read base j
+  int best_score = 0, best_diagonal = 0, best_query_begin = 0, best_query_end = -1;
+  const int lowest  = std::max(1 - read_length, left + inserted + right_flank - read_length);
+  const int highest = std::min(junction_length - 1, left - min_flank);
+  for (unsigned int i = 0; i < diagonals.size(); ++i) {
+    const int diagonal = diagonals[i];
+    if (diagonal < lowest || diagonal > highest) continue;
+    const int query_low  = std::max(0, -diagonal);
+    const int query_high = std::min(read_length, junction_length - diagonal);
+    int score = 0, query_begin = query_low;
+    for (int j = query_low; j < query_high; ++j) {
+      const int8_t base = ref[j + diagonal];
+      if (read[j] != 4 && base != 4) score += (read[j] == base) ? match : -mismatch;
+      if (score <= 0) {
+        score = 0;
+        query_begin = j + 1;
+      } else if (score > best_score) {
+        best_score       = score;
+        best_diagonal    = diagonal;
+        best_query_begin = query_begin;
+        best_query_end   = j;
+      }
+    }
+  }
+  if (best_score == 0) return false;
+
+  const int left_length  = left - (best_query_begin + best_diagonal);
+  const int right_length = best_query_end + best_diagonal - (left + inserted) + 1;
+  if (left_length <= 0 || right_length <= 0) return false;
+
+  al->Clear();
+  al->sw_score          = best_score;
+  al->ref_begin         = junction.position - left_length;
+  al->ref_end           = junction.position + deleted + right_length - 1;
+  al->query_begin       = best_query_begin;
+  al->query_end         = best_query_end;
+  al->ref_end_next_best = -1;
+  for (int j = best_query_begin; j <= best_query_end; ++j)
+    if (read[j] != ref[j + best_diagonal]) ++al->mismatches;
+  al->mismatches += junction.length;
+
+  std::ostringstream cigar_string;
+  if (al->query_begin > 0) {
+    al->cigar.push_back((al->query_begin << 4) | 0x04);
+    cigar_string << al->query_begin << 'S';
+  }
+  al->cigar.push_back(left_length << 4);
+  al->cigar.push_back((junction.length << 4) | (junction.insertion ? 0x01 : 0x02));
+  al->cigar.push_back(right_length << 4);
+  cigar_string << left_length << 'M' << junction.length << (junction.insertion ? 'I' : 'D')
+               << right_length << 'M';
+  const int end_clip = read_length - al->query_end - 1;
+  if (end_clip > 0) {
+    al->cigar.push_back((end_clip << 4) | 0x04);
+    cigar_string << end_clip << 'S';
+  }
+  al->cigar_string = cigar_string.str();
+
+  return true;
+}
+
+// Whether al aligns at least rate of the read_length bases, so that the
+//  searches of other events are not worth their cost; never for rate 0.
+bool IsDecisive(const StripedSmithWaterman::Alignment& al, const float& rate,
+                const int& read_length) {
+  if (rate <= 0.0) return false;
+  return al.query_end - al.query_begin + 1 >= rate * read_length;
+}
+
 bool CheckSetting(const SR_Reference* reference, const Technology technology) {
   if (reference == NULL) return false;
   if (technology == TECH_NONE) return false;
@@ -215,14 +338,26 @@ Aligner::Aligner()
     , query_region_(NULL)
     , hashes_(NULL)
     , hashes_special_(NULL)
+    , hashes_special_inv_(NULL)
+    , seed_special_inversion_(false)
+    , special_inversion_seeded_(false)
     , hash_length_()
     , special_ref_view_()
+    , local_window_cache_()
+    , search_memo_()
+    , junction_cache_()
+    , cascade_skips_()
+    , translated_special_()
+    , special_kmer_filter_(NULL)
+    , split_indel_aligner_()
     , stripe_sw_indel_()
     , stripe_sw_normal_() {
   query_region_     = SR_QueryRegionAlloc();
   hashes_           = HashRegionTableAlloc();
   hashes_special_   = HashRegionTableAlloc();
+  hashes_special_inv_ = HashRegionTableAlloc();
   special_ref_view_ = SR_RefViewAlloc();
+  special_kmer_filter_ = SR_KmerFilterAlloc();
 
   stripe_sw_indel_.Clear();
   stripe_sw_indel_.ReBuild(30,60,60,1);
@@ -241,26 +376,39 @@ Aligner::Aligner(const SR_Reference* reference,
     , technology_(technology)
     , reference_(reference)
     , hash_table_(hash_table)
-    , reference_special_(reference_special)
-    , hash_table_special_(hash_table_special)
+    , reference_special_(NULL)
+    , hash_table_special_(NULL)
     , reference_header_(reference_header)
     , query_region_(NULL)
     , hashes_(NULL)
     , hashes_special_(NULL)
+    , hashes_special_inv_(NULL)
+    , seed_special_inversion_(false)
+    , special_inversion_seeded_(false)
     , hash_length_()
     , special_ref_view_()
+    , local_window_cache_()
+    , search_memo_()
+    , junction_cache_()
+    , cascade_skips_()
+    , translated_special_()
+    , special_kmer_filter_(NULL)
+    , split_indel_aligner_()
     , stripe_sw_indel_()
     , stripe_sw_normal_() {
   
   query_region_     = SR_QueryRegionAlloc();
   hashes_           = HashRegionTableAlloc();
   hashes_special_   = HashRegionTableAlloc();
+  hashes_special_inv_ = HashRegionTableAlloc();
   special_ref_view_ = SR_RefViewAlloc();
+  special_kmer_filter_ = SR_KmerFilterAlloc();
 
   stripe_sw_indel_.Clear();
   stripe_sw_indel_.ReBuild(30,60,60,1);
   stripe_sw_normal_.Clear();
   stripe_sw_normal_.ReBuild(1,3,5,2);
+  SetSpecialReference(reference_special, hash_table_special);
   //stripe_sw_aligner_.SetGapPenalty(4, 0);
 
   //hash_length_.fragLen = fragment_length;
@@ -278,19 +426,49 @@ bool Aligner::SetReference(
   reference_          = reference;
   hash_table_         = hash_table;
   technology_         = technology;
-  reference_special_  = reference_special;
-  hash_table_special_ = hash_table_special;
   reference_header_   = reference_header;
+  SetSpecialReference(reference_special, hash_table_special);
+  // Only what is cached for the normal reference is out of date
+  local_window_cache_.Clear();
+  search_memo_.ClearNormal();
+  junction_cache_.Clear();
   return true;
 }
 
+// @function: Sets the special references and builds what the special
+//            searches use of them: the sequence translated for SSW and the
+//            presence filter of their hashes. Nothing is rebuilt when the
+//            references are the ones already set, so a chromosome switch
+//            keeps them; the content of set references must not change.
+void Aligner::SetSpecialReference(const SR_Reference* reference_special,
+                                  const SR_InHashTable* hash_table_special) {
+  if (reference_special == reference_special_ && hash_table_special == hash_table_special_)
+    return;
+
+  reference_special_  = reference_special;
+  hash_table_special_ = hash_table_special;
+  search_memo_.Clear();
+  translated_special_.clear();
+  SR_KmerFilterClear(special_kmer_filter_);
+  if (reference_special_ == NULL) return;
+
+  translated_special_.resize(reference_special_->seqLen + 1);
+  stripe_sw_normal_.Translate(reference_special_->sequence, reference_special_->seqLen,
+                              &translated_special_[0]);
+  if (hash_table_special_ != NULL)
+    SR_KmerFilterLoad(special_kmer_filter_, reference_special_->sequence,
+                      reference_special_->seqLen, hash_table_special_->hashSize);
+}
+
 
 
 Aligner::~Aligner() {
   SR_QueryRegionFree(query_region_);
   HashRegionTableFree(hashes_);
   HashRegionTableFree(hashes_special_);
+  HashRegionTableFree(hashes_special_inv_);
   SR_RefViewFree(special_ref_view_);
+  SR_KmerFilterFree(special_kmer_filter_);
 }
 
 void Aligner::LoadRegionType(const bam1_t& anchor) {
@@ -323,6 +501,7 @@ bool Aligner::AlignCandidate(const TargetEvent& target_event,
   hash_length_.fragLen    = target_region.fragment_length;
   hash_length_.closeRange = target_region.local_window_size;
   hash_length_.farRange   = target_region.discovery_window_size;
+
   while (SR_QueryRegionLoadPair(query_region_, al_ite) == SR_OK) {
     // TODO@WP: it may be removed later
     //if (query_region_->algnType != SR_UNIQUE_ORPHAN) {
@@ -389,15 +568,34 @@ void Aligner::Align(const TargetEvent& target_event,
 
   AlignmentCollection al_collection;
   StripedSmithWaterman::Alignment indel_al;
+  const int read_length = query_region_->pOrphan->core.l_qseq;
+  // ===============================================
+  // Try to align to the junctions found in the window
+  // ===============================================
+  bool junction_found = false;
+  if (target_event.medium_sized_indel && target_region.junction_cache) {
+    junction_found = SearchJunction(target_region, alignment_filter, &indel_al);
+    if (junction_found) {
+      al_collection.PushANewEvent(kMediumIndel);
+      al_collection.PushAlignment(indel_al);
+    }
+  }
+
   // ====================================
   // Try to align for medium-sized INDELs
   // ====================================
-  if (target_event.medium_sized_indel) {
+  string indel_seq;
+  bool decisive_indel = junction_found;
+  if (target_event.medium_sized_indel && !junction_found) {
     bool medium_indel_found = 
         SearchMediumIndel(target_region, alignment_filter, &indel_al);
     if (medium_indel_found) { // push the event and its corresponding alignments in the collection
       al_collection.PushANewEvent(kMediumIndel);
       al_collection.PushAlignment(indel_al);
+      // the orphan as it is aligned, for the junction of the event
+      if (target_region.junction_cache)
+        indel_seq.assign(query_region_->orphanSeq, query_region_->pOrphan->core.l_qseq);
+      decisive_indel = IsDecisive(indel_al, target_region.decisive_indel_rate, read_length);
     }
   }
 
@@ -405,8 +603,8 @@ void Aligner::Align(const TargetEvent& target_event,
   // Try to align first partial locally
   // ==================================
   StripedSmithWaterman::Alignment local_al;
-  bool first_partial_found = 
-      SearchLocalPartial(target_region, alignment_filter, &local_al);
+  bool first_partial_found = !junction_found
+      && SearchLocalPartial(target_region, alignment_filter, &local_al);
 
   // Since we do not find the first partial, we do not try second partial.
   if (first_partial_found) {
@@ -414,13 +612,32 @@ void Aligner::Align(const TargetEvent& target_event,
     al_collection.PushAlignment(local_al);
   }
 
+  // ================================================================
+  // The special searches are the most expensive ones; skip them when
+  // the alignments above already decide the event. They need the
+  // first partial anyway.
+  // ================================================================
+  const unsigned int special_searches = !target_event.special_insertion || !first_partial_found ? 0
+      : (target_event.special_inversive_insertion ? 2 : 1);
+  bool search_special = special_searches > 0;
+  if (search_special && decisive_indel) {
+    cascade_skips_.after_indel += special_searches;
+    search_special = false;
+  } else if (search_special
+      && IsDecisive(local_al, target_region.decisive_local_rate, read_length)) {
+    cascade_skips_.after_local += special_searches;
+    search_special = false;
+  }
+
   // ==================================
   // Try to align to special insertions
   // ==================================
   StripedSmithWaterman::Alignment special_al;
-  if (first_partial_found && target_event.special_insertion) {
+  if (search_special) {
     const bool inversive = false;
-    const bool special_found = SearchSpecialReference(target_region, alignment_filter, inversive, &special_al);
+    const bool seed_inversion = target_event.special_inversive_insertion;
+    const bool special_found = SearchSpecialReference(target_region, alignment_filter, inversive,
+                                                      seed_inversion, &special_al);
     if (special_found) {
       // push the event and its corresponding alignments in the collection
       al_collection.PushANewEvent(kSpecialInsertion);
@@ -433,9 +650,11 @@ void Aligner::Align(const TargetEvent& target_event,
   // Try to align to special insertions
   // ==================================
   StripedSmithWaterman::Alignment special_inv_al;
-  if (first_partial_found && target_event.special_insertion && target_event.special_inversive_insertion) {
+  if (search_special && target_event.special_inversive_insertion) {
     const bool inversive = true;
-    const bool special_inv_found = SearchSpecialReference(target_region, alignment_filter, inversive, &special_inv_al);
+    const bool seed_inversion = false;
+    const bool special_inv_found = SearchSpecialReference(target_region, alignment_filter, inversive,
+                                                          seed_inversion, &special_inv_al);
     if (special_inv_found) {
       // push the event and its corresponding alignments in the collection
       al_collection.PushANewEvent(kSpecialInvertedInsertion);
@@ -449,6 +668,8 @@ void Aligner::Align(const TargetEvent& target_event,
   vector <StripedSmithWaterman::Alignment*> ssw_al_for_best_event;
   vector <Alignment*> common_al_for_best_event;
   al_collection.GetMostConfidentEvent(&best_event, &ssw_al_for_best_event, &common_al_for_best_event);
+  if (!indel_seq.empty() && best_event.medium_sized_indel && !ssw_al_for_best_event.empty())
+    AddJunction(*ssw_al_for_best_event[0], indel_seq);
   bam1_t* primary_partial = NULL;
   StoreAlignment(best_event, ssw_al_for_best_event, common_al_for_best_event, 
       *query_region_->pAnchor, *query_region_->pOrphan, alignments, &primary_partial);
@@ -484,6 +705,11 @@ inline bool Aligner::ResetLocalSmithWatermanScore(
   return stripe_sw_normal_.ReBuild(match_score, mismatch_penalty, gap_opening_penalty, gap_extending_penalty);
 }
 
+uint64_t Aligner::GetMaskedSeedCount(void) const {
+  return hashes_->numMaskedSeeds + hashes_special_->numMaskedSeeds
+         + hashes_special_inv_->numMaskedSeeds;
+}
+
 // @function: Gets alignment from the hashes_collection by given id 
 //            in hashes_collection
 bool Aligner::GetAlignment(
@@ -492,19 +718,24 @@ bool Aligner::GetAlignment(
     const bool& special,
     const int& read_length,
     const char* read_seq,
+    const StripedSmithWaterman::Filter& filter,
     StripedSmithWaterman::Alignment* al){
   
   if (static_cast<int>(id) >= hashes_collection.GetSize()) {
     return false;
   } else {
     int hash_begin = (hashes_collection.Get(id))->refBegins[0];
+    // hashed positions are relative to the loaded (possibly sliced) sequence
+    if (!special) hash_begin += reference_->seqBegin;
     int begin, end;
     GetTargetRefRegion(read_length, hash_begin, special, &begin, &end);
     int ref_length = end - begin + 1;
-    const char* ref_seq = GetSequence(begin, special);
-    StripedSmithWaterman::Filter filter;
-    filter.distance_filter = read_length * 2;
-    stripe_sw_normal_.Align(read_seq, ref_seq, ref_length, filter, al);
+    if (special) {
+      stripe_sw_normal_.Align(read_seq, &translated_special_[begin], ref_length, filter, al);
+    } else {
+      const char* ref_seq = GetSequence(begin, special);
+      stripe_sw_normal_.Align(read_seq, ref_seq, ref_length, filter, al);
+    }
     //BandedSmithWatermanHashRegion hr;
     //hr.reference_begin = hash_begin - begin;
     //hr.query_begin = (hashes_collection.Get(id))->queryBegin;
@@ -518,8 +749,35 @@ bool Aligner::GetAlignment(
   }
 }
 
+// @function: Sets the score filter of filter to the lowest SSW score of
+//            stripe_sw_normal_ with which an alignment of read_seq may pass
+//            alignment_filter, so that the begin position and the cigar are
+//            only searched for the alignments that may pass.
+void Aligner::SetPassingScoreFilter(const AlignmentFilter& alignment_filter,
+    const string& read_seq, StripedSmithWaterman::Filter* filter) const {
+  int unknown_bases = 0;
+  for (unsigned int i = 0; i < read_seq.size(); ++i) {
+    switch (read_seq[i]) {
+      case 'A': case 'C': case 'G': case 'T':
+      case 'a': case 'c': case 'g': case 't':
+        break;
+      default:
+        ++unknown_bases;
+    }
+  }
+
+  const int min_score = AlignmentFilterApplication::GetMinimumPassingScore(
+      alignment_filter, read_seq.size(), unknown_bases,
+      stripe_sw_normal_.GetMatchScore(), stripe_sw_normal_.GetMismatchPenalty(),
+      stripe_sw_normal_.GetGapOpeningPenalty(), stripe_sw_normal_.GetGapExtendingPenalty());
+  filter->score_filter = min_score < USHRT_MAX ? min_score : USHRT_MAX;
+  filter->filter_begin_position = true;
+}
+
 // @function Given a pivot (hash_begin) and the length that you want to extend,
 //           the function will set the valid begin and end after extending.
+//           For the normal reference, positions are chromosome coordinates
+//           and the region is clipped to the loaded slice.
 // @param  extend_length The length that you want to extend.
 // @param  hash_begin    A pivot that you want to extend the region according to.
 // @param  special       In the special reference?
@@ -533,71 +791,115 @@ void Aligner::GetTargetRefRegion(const int& extend_length, const int& hash_begin
     SR_GetRefFromSpecialPos(special_ref_view_, &ref_id, &pos, reference_header_, reference_special_, hash_begin);
 
   int seq_length = special ? special_ref_view_->seqLen : reference_->seqLen;
-
-  int forward_shift;
-  if (pos < static_cast<uint32_t>(extend_length)) forward_shift = pos;
-  else forward_shift = extend_length;
-
-  int backward_shift;
-  if ((pos + static_cast<uint32_t>(extend_length) + 1) > static_cast<uint32_t>(seq_length)) 
-    backward_shift = seq_length - pos - 1;
-  else 
-    backward_shift = extend_length;
-  
-  *begin = hash_begin - forward_shift;
-  *end   = hash_begin + backward_shift;
+  // the first and the last valid positions
+  const int lowest  = special ? hash_begin - static_cast<int>(pos) 
+                              : static_cast<int>(reference_->seqBegin);
+  const int highest = lowest + seq_length - 1;
+
+  *begin = hash_begin - extend_length;
+  if (*begin < lowest) *begin = lowest;
+  *end   = hash_begin + extend_length;
+  if (*end > highest) *end = highest;
 }
 
-bool Aligner::SearchLocalPartial(const TargetRegion& target_region,
-                                 const AlignmentFilter& alignment_filter,
-                                 StripedSmithWaterman::Alignment* local_al) {
-#ifdef VERBOSE_DEBUG
-  fprintf(stderr, "=== Local partial alignment ===\n");
-#endif
-
+// @function: Sets the orphan of query_region_ in the orientation of the
+//            standard region type and gets the local window searched for
+//            it, which is shared by the first partial and the medium-sized
+//            indel alignments.
+// @return  False if the window is empty.
+bool Aligner::LoadLocalWindow(const TargetRegion& target_region,
+    SearchRegionType::RegionType* region_type, int* pivot, int* begin, int* end) {
   namespace Constant = BamFlagConstant;
   const bool is_anchor_mate1 = query_region_->pAnchor->core.flag & Constant::kBamFMate1;
   const bool is_anchor_forward = !bam1_strand(query_region_->pAnchor);
   search_region_type_.SetTechnologyAndAnchorMate1(technology_, is_anchor_mate1);
-  SearchRegionType::RegionType region_type;
 
-  // ============================================
-  // Loads hashes for the first partial alignment
-  // ============================================
-  search_region_type_.GetStandardType(is_anchor_forward, &region_type);
+  // ============================
+  // Get the standard region type
+  // ============================
+  search_region_type_.GetStandardType(is_anchor_forward, region_type);
+
+  //fprintf(stderr, "%c%c%c\n", region_type->upstream?'T':'F', region_type->sequence_inverse?'T':'F', region_type->sequence_complement?'T':'F');
 
+  // ==============================================
   // Calculate the pivot position and target region
+  // ==============================================
   int anchor_pos = query_region_->pAnchor->core.pos;
-  int pivot = region_type.upstream ? anchor_pos + target_region.fragment_length
-                                   : anchor_pos - target_region.fragment_length;
-  if (pivot < 0) pivot = 0;
+  *pivot = region_type->upstream ? anchor_pos + target_region.fragment_length
+                                 : anchor_pos - target_region.fragment_length;
+  if (*pivot < 0) *pivot = 0;
 
   // Get the region according to the pivot and local_window_size
-  int begin, end;
   bool special = false;
-  GetTargetRefRegion(target_region.local_window_size, pivot, special, &begin, &end);
+  GetTargetRefRegion(target_region.local_window_size, *pivot, special, begin, end);
 #ifdef VERBOSE_DEBUG
-  fprintf(stderr, "looking window: %d-%d\n", begin, end);
+  fprintf(stderr, "looking window: %d-%d\n", *begin, *end);
 #endif
-  if (end < begin) return false;
+  if (*end < *begin) return false;
 
+  // =====================
   // Get the read sequence
-  SetTargetSequence(region_type, query_region_);
+  // =====================
+  SetTargetSequence(*region_type, query_region_);
+  return true;
+}
+
+bool Aligner::SearchLocalPartial(const TargetRegion& target_region,
+                                 const AlignmentFilter& alignment_filter,
+                                 StripedSmithWaterman::Alignment* local_al) {
+#ifdef VERBOSE_DEBUG
+  fprintf(stderr, "=== Local partial alignment ===\n");
+#endif
+
+  SearchRegionType::RegionType region_type;
+  int pivot, begin, end;
+  if (!LoadLocalWindow(target_region, &region_type, &pivot, &begin, &end)) return false;
+
   string read_seq;
   read_seq.assign(query_region_->orphanSeq, query_region_->pOrphan->core.l_qseq);
 #ifdef VERBOSE_DEBUG
   fprintf(stderr, "%s\n", read_seq.c_str());
 #endif
 
+  SearchMemo::Key key;
+  SetSearchKey(SearchMemo::kLocalPartial, region_type, query_region_->pAnchor->core.tid,
+               begin, end, read_seq, &key);
+  bool found = false;
+  if (search_memo_.Get(key, &found, local_al)) {
+    // Only the fields given by the anchor are set again
+    local_al->is_reverse = region_type.sequence_inverse;
+    local_al->is_complement = region_type.sequence_complement;
+    if (found) local_al->ref_id = query_region_->pAnchor->core.tid;
+    return found;
+  }
+
+  found = AlignLocalPartial(target_region, alignment_filter, region_type, read_seq,
+                            pivot, begin, end, local_al);
+  search_memo_.Put(key, found, *local_al);
+  return found;
+}
+
+// @function: Aligns the orphan in query_region_ to the local window
+//            [begin, end] loaded by LoadLocalWindow.
+bool Aligner::AlignLocalPartial(const TargetRegion& target_region,
+                                const AlignmentFilter& alignment_filter,
+                                const SearchRegionType::RegionType& region_type,
+                                const string& read_seq,
+                                const int& pivot,
+                                int begin,
+                                const int& end,
+                                StripedSmithWaterman::Alignment* local_al) {
   // Apply SSW to the region
-  const int ref_length = end - begin + 1;
-  const char* ref_seq = GetSequence(begin, special);
   StripedSmithWaterman::Filter filter;
   // If the difference between beginnng and ending is larger than distance_filter,
   // then we don't think that it's medium-sized indels and don't need to trace
   // the alignment.
   filter.distance_filter = read_seq.size() * 2;
-  stripe_sw_normal_.Align(read_seq.c_str(), ref_seq, ref_length, filter, local_al);
+  // Alignments that cannot pass the filters below need no traceback
+  SetPassingScoreFilter(alignment_filter, read_seq, &filter);
+  if (target_region.ungapped_xdrop <= 0
+      || !AlignUngapped(target_region, alignment_filter, read_seq, pivot, begin, end, local_al))
+    AlignLocalWindow(stripe_sw_normal_, filter, read_seq, pivot, target_region, end, &begin, local_al);
   local_al->is_reverse = region_type.sequence_inverse;
   local_al->is_complement = region_type.sequence_complement;
   // Return false since no alignment is found
@@ -641,6 +943,7 @@ if (local_al->cigar.empty()) return false;
 bool Aligner::SearchSpecialReference(const TargetRegion& target_region,
                                      const AlignmentFilter& alignment_filter,
 				     const bool& inversive,
+				     const bool& seed_inversion,
 				     StripedSmithWaterman::Alignment* special_al)
 {
 #ifdef VERBOSE_DEBUG
@@ -654,7 +957,6 @@ bool Aligner::SearchSpecialReference(const TargetRegion& target_region,
   SearchRegionType::RegionType region_type;
   if (inversive) search_region_type_.GetInversionType(is_anchor_forward, &region_type);
   else search_region_type_.GetStandardType(is_anchor_forward, &region_type);
-  const int read_length = query_region_->pOrphan->core.l_qseq;
 
   // Get the read sequence
   SetTargetSequence(region_type, query_region_);
@@ -664,17 +966,72 @@ bool Aligner::SearchSpecialReference(const TargetRegion& target_region,
   fprintf(stderr, "%s\n", read_seq.c_str());
 #endif
 
+  // The inverted orphan is seeded by the standard search if it needs seeds
+  seed_special_inversion_ = false;
+  if (!inversive) special_inversion_seeded_ = false;
+
+  // Most orphans share no hash with the special references at all
+  if (!SR_KmerFilterMayContain(special_kmer_filter_, read_seq.c_str(), read_seq.size()))
+    return false;
+
+  SearchMemo::Key key;
+  SetSearchKey(inversive ? SearchMemo::kSpecialInversion : SearchMemo::kSpecial,
+               region_type, -1, 0, 0, read_seq, &key);
+  bool found = false;
+  if (search_memo_.Get(key, &found, special_al)) {
+    // Only the fields given by the anchor are set again
+    special_al->is_reverse = region_type.sequence_inverse;
+    special_al->is_complement = region_type.sequence_complement;
+    return found;
+  }
+
+  if (seed_inversion) {
+    SearchRegionType::RegionType inversion_type;
+    search_region_type_.GetInversionType(is_anchor_forward, &inversion_type);
+    seed_special_inversion_ = NeedsSpecialSeeds(SearchMemo::kSpecialInversion, inversion_type);
+  }
+
+  found = AlignSpecialReference(alignment_filter, region_type, read_seq, special_al);
+  search_memo_.Put(key, found, *special_al);
+  return found;
+}
+
+// @function: Tells if the special search of the orphan in query_region_
+//            as region_type would seed it, i.e. the orphan passes the
+//            special hash filter and the search is not memoized.
+bool Aligner::NeedsSpecialSeeds(const SearchMemo::Search& search,
+                                const SearchRegionType::RegionType& region_type) {
+  string read_seq;
+  read_seq.assign(GetTargetSequence(region_type, *query_region_), query_region_->pOrphan->core.l_qseq);
+  if (!SR_KmerFilterMayContain(special_kmer_filter_, read_seq.c_str(), read_seq.size()))
+    return false;
+
+  SearchMemo::Key key;
+  SetSearchKey(search, region_type, -1, 0, 0, read_seq, &key);
+  return !search_memo_.Has(key);
+}
+
+// @function: Aligns the orphan in query_region_ to the special reference.
+bool Aligner::AlignSpecialReference(const AlignmentFilter& alignment_filter,
+                                    const SearchRegionType::RegionType& region_type,
+                                    const string& read_seq,
+                                    StripedSmithWaterman::Alignment* special_al) {
+  const int read_length = read_seq.size();
+
   // ====================
   // Loads special hashes
   // ====================
   HashesCollection hashes_collection_special;
-  const bool load_hash_okay = LoadHashes(true, read_length, &hashes_collection_special);
+  const bool load_hash_okay = LoadSpecialHashes(read_length, &hashes_collection_special);
   if (!load_hash_okay) return false;
 
   // Get an alignment
   const int best2 = hashes_collection_special.GetSize() - 1;
+  StripedSmithWaterman::Filter filter;
+  filter.distance_filter = read_length * 2;
+  SetPassingScoreFilter(alignment_filter, read_seq, &filter);
   bool isSpecialGet = GetAlignment(hashes_collection_special, 
-                                   best2, true, read_length, read_seq.c_str(), special_al);
+                                   best2, true, read_length, read_seq.c_str(), filter, special_al);
   if (!isSpecialGet) return false;
 
   // Apply the filter
@@ -718,66 +1075,278 @@ bool Aligner::LoadHashes(const bool& special, const int& read_length, HashesColl
   HashRegionTableInit(hashes, read_length);
   SR_QueryRegionSetRangeSpecial(query_region_, ref->seqLen);
   HashRegionTableLoad(hashes, hash_table, query_region_);
-  hashes_collection->Init(*(hashes->pBestCloseRegions));
-  hashes_collection->SortByLength();
+  // the longest regions are kept while hashing, so nothing has to be sorted
+  hashes_collection->Init(hashes->pTopRegions, hashes->numTopRegions);
+  if (hashes_collection->Get(hashes_collection->GetSize() - 1) == NULL) return false;
+  if (hashes_collection->Get(hashes_collection->GetSize() - 1)->length == 0) return false;
+
+  return true;
+}
+
+// @function: LoadHashes for the special reference. The orphan and its
+//            reverse complement, the inverted orphan, are seeded in one
+//            pass if seed_special_inversion_ is set; the search of the
+//            inverted orphan then takes the hashes seeded for it.
+bool Aligner::LoadSpecialHashes(const int& read_length, HashesCollection* hashes_collection) {
+  HashRegionTable* hashes = hashes_special_;
+  if (special_inversion_seeded_) {
+    hashes = hashes_special_inv_;
+    special_inversion_seeded_ = false;
+  } else if (seed_special_inversion_) {
+    HashRegionTableInit(hashes_special_, read_length);
+    HashRegionTableInit(hashes_special_inv_, read_length);
+    SR_QueryRegionSetRangeSpecial(query_region_, reference_special_->seqLen);
+    HashRegionTableLoadBothStrands(hashes_special_, hashes_special_inv_, hash_table_special_, query_region_);
+    seed_special_inversion_ = false;
+    special_inversion_seeded_ = true;
+  } else {
+    return LoadHashes(true, read_length, hashes_collection);
+  }
+
+  hashes_collection->Init(hashes->pTopRegions, hashes->numTopRegions);
   if (hashes_collection->Get(hashes_collection->GetSize() - 1) == NULL) return false;
   if (hashes_collection->Get(hashes_collection->GetSize() - 1)->length == 0) return false;
 
   return true;
 }
 
+// @function: Seeds the orphan against the cached hash table of the local
+//            window around pivot; only the hits in [begin, end] are used.
+//            The regions are stored in hashes_ with positions relative to
+//            the table; the chromosome position of a hit is its refBegins
+//            plus table_begin.
+// @return    False if no hash of the orphan is found in the window.
+bool Aligner::LoadLocalHashes(const int& pivot, const int& window_size,
+    const int& begin, const int& end, const int& read_length,
+    HashesCollection* hashes_collection, int* table_begin) {
+  const SR_InHashTable* local_table = 
+      local_window_cache_.GetHashTable(*reference_, GetLocalHashSize(), window_size, pivot, table_begin);
+  if (local_table == NULL || end < begin) return false;
+
+  HashRegionTableInit(hashes_, read_length);
+  SR_QueryRegionSetRangeWindow(query_region_, begin - *table_begin, end - *table_begin);
+  HashRegionTableLoad(hashes_, local_table, query_region_);
+  hashes_collection->Init(hashes_->pTopRegions, hashes_->numTopRegions);
+
+  return hashes_collection->GetSize() > 0;
+}
+
+// @function: Extends the seeds of the orphan in the window [begin, end]
+//            along their diagonals without gaps, as far as the score does
+//            not drop more than ungapped_xdrop below the best one; the seeds
+//            are the ones of the seed band. Bases are scored as SSW scores
+//            them. The best extension is set in al, with positions relative
+//            to begin, if it passes alignment_filter as it is.
+// @return    False if there is no seed or the best extension fails the
+//            filters, i.e. gaps are needed.
+bool Aligner::AlignUngapped(const TargetRegion& target_region,
+    const AlignmentFilter& alignment_filter, const string& read_seq,
+    const int& pivot, const int& begin, const int& end,
+    StripedSmithWaterman::Alignment* al) {
+  const int read_length = read_seq.size();
+  HashesCollection hashes_collection;
+  int table_begin = 0;
+  if (read_length == 0 || !LoadLocalHashes(pivot, target_region.local_window_size, begin, end,
+                                           read_length, &hashes_collection, &table_begin))
+    return false;
+
+  int window_begin = 0;
+  const int8_t* window_seq = local_window_cache_.GetTranslatedSequence(
+      *reference_, stripe_sw_normal_, target_region.local_window_size, pivot, &window_begin);
+  if (window_seq == NULL) return false;
+  vector<int8_t> read(read_length);
+  stripe_sw_normal_.Translate(read_seq.c_str(), read_length, &read[0]);
+
+  const int match    = stripe_sw_normal_.GetMatchScore();
+  const int mismatch = stripe_sw_normal_.GetMismatchPenalty();
+  const int xdrop    = target_region.ungapped_xdrop;
+  const int min_seed_length = 2 * GetLocalHashSize();
+  int best_score = 0, best_diagonal = 0, best_query_begin = 0, best_query_end = -1;
+  for (int i = hashes_collection.GetSize() - 1; i >= 0; --i) {
+    const BestRegion* seed = hashes_collection.Get(i);
+    if (i < hashes_collection.GetSize() - 1 && static_cast<int>(seed->length) < min_seed_length) break;
+    // the reference position of the first read base on the seed diagonal
+    const int diagonal = seed->refBegins[0] + table_begin - seed->queryBegin;
+    // the read bases whose diagonal positions are in the window
+    const int query_low  = std::max(0, begin - diagonal);
+    const int query_high = std::min(read_length - 1, end - diagonal);
+    const int seed_begin = seed->queryBegin;
+    if (seed_begin < query_low || seed_begin > query_high) continue;
+
+    int query_begin = 0, query_end = 0;
+    const int score = UngappedExtension::Extend(&read[0], window_seq + (diagonal - window_begin),
+        query_low, query_high, seed_begin, match, mismatch, xdrop, &query_begin, &query_end);
+    if (score > best_score) {
+      best_score       = score;
+      best_diagonal    = diagonal;
+      best_query_begin = query_begin;
+      best_query_end   = query_end;
+    }
+  }
+  if (best_score == 0) return false;
+
+  UngappedExtension::SetAlignment(&read[0], window_seq + (best_diagonal - window_begin),
+      read_length, best_score, best_query_begin, best_query_end, best_diagonal - begin, al);
+
+  // An ungapped alignment is not changed by TrimAlignment
+  namespace filter_app = AlignmentFilterApplication;
+  return filter_app::PassMismatchFilter(*al, alignment_filter, 0)
+      && filter_app::FilterByAlignedBaseThreshold(alignment_filter, *al, read_length);
+}
+
+// @function: Aligns the orphan (already set by SetTargetSequence) to the
+//            window [begin, end] of the normal reference. With a seed band,
+//            only the reference within local_seed_band of the diagonals of
+//            the seeds is aligned; the seeds are the longest one and the
+//            other long ones, which hold both sides of a medium-sized indel.
+//            The whole window is used if there is no seed or nothing is
+//            aligned within the band.
+// @param  begin The window begin; set to the begin of the reference that 
+//               is actually aligned, to which al positions are relative.
+void Aligner::AlignLocalWindow(const StripedSmithWaterman::Aligner& stripe_sw,
+    const StripedSmithWaterman::Filter& filter, const string& read_seq,
+    const int& pivot, const TargetRegion& target_region, const int& end,
+    int* begin, StripedSmithWaterman::Alignment* al) {
+  const int read_length = read_seq.size();
+  HashesCollection hashes_collection;
+  int table_begin = 0;
+  if (target_region.local_seed_band > 0
+      && LoadLocalHashes(pivot, target_region.local_window_size, *begin, end, 
+                         read_length, &hashes_collection, &table_begin)) {
+    // a seed shorter than two hashes may well be a random hit
+    const int min_seed_length = 2 * GetLocalHashSize();
+    int min_diagonal = INT_MAX, max_diagonal = INT_MIN;
+    for (int i = hashes_collection.GetSize() - 1; i >= 0; --i) {
+      const BestRegion* seed = hashes_collection.Get(i);
+      if (i < hashes_collection.GetSize() - 1 && static_cast<int>(seed->length) < min_seed_length) break;
+      // the reference position of the first read base on the seed diagonal
+      const int diagonal = seed->refBegins[0] + table_begin - seed->queryBegin;
+      if (diagonal < min_diagonal) min_diagonal = diagonal;
+      if (diagonal > max_diagonal) max_diagonal = diagonal;
+    }
+
+    int band_begin = min_diagonal - target_region.local_seed_band;
+    if (band_begin < *begin) band_begin = *begin;
+    int band_end = max_diagonal + read_length - 1 + target_region.local_seed_band;
+    if (band_end > end) band_end = end;
+
+    if (band_begin <= band_end) {
+      AlignNormalReference(stripe_sw, filter, read_seq, pivot, 
+                           target_region.local_window_size, band_begin, band_end, al);
+      // an alignment below the score filter is not traced; it is
+      //  rejected as the traced one would be
+      if (!al->cigar.empty() || al->sw_score < filter.score_filter) {
+        *begin = band_begin;
+        return;
+      }
+    }
+  }
+
+  AlignNormalReference(stripe_sw, filter, read_seq, pivot, 
+                       target_region.local_window_size, *begin, end, al);
+}
+
+// @function: Aligns the read to [begin, end] of the normal reference as two
+//            ungapped pieces joined by one deletion or insertion, scored by
+//            stripe_sw_indel_; see SplitIndelAligner. A piece shorter than
+//            the local hash size is likely a random hit in the window.
+// @param  al  The alignment with positions relative to begin.
+// @return True if a join is found.
+bool Aligner::AlignSplitIndel(const string& read_seq, const int& pivot,
+    const int& window_size, const int& begin, const int& end,
+    StripedSmithWaterman::Alignment* al) {
+  al->Clear();
+  const int read_length = read_seq.size();
+  const int ref_length  = end - begin + 1;
+  if (read_length < 2 || ref_length < 2) return false;
+
+  int window_begin = 0;
+  const int8_t* window_seq = local_window_cache_.GetTranslatedSequence(
+      *reference_, stripe_sw_normal_, window_size, pivot, &window_begin);
+  vector<int8_t> translated;
+  const int8_t* ref = NULL;
+  if (window_seq != NULL) {
+    ref = window_seq + (begin - window_begin);
+  } else {
+    translated.resize(ref_length);
+    stripe_sw_indel_.Translate(GetSequence(begin, false), translated.size(), &translated[0]);
+    ref = &translated[0];
+  }
+  vector<int8_t> read(read_length);
+  stripe_sw_indel_.Translate(read_seq.c_str(), read.size(), &read[0]);
+
+  return split_indel_aligner_.Align(&read[0], read_length, ref, ref_length,
+      stripe_sw_indel_.GetMatchScore(), stripe_sw_indel_.GetMismatchPenalty(),
+      stripe_sw_indel_.GetGapOpeningPenalty(), stripe_sw_indel_.GetGapExtendingPenalty(),
+      GetLocalHashSize(), al);
+}
+
+// @function: Aligns the read to [begin, end] of the normal reference, which
+//            must be in the window of pivot. The bases are taken from the
+//            window cache already translated; every SSW aligner of scissors
+//            uses the default translation, so one copy serves all of them.
+void Aligner::AlignNormalReference(const StripedSmithWaterman::Aligner& stripe_sw,
+    const StripedSmithWaterman::Filter& filter, const string& read_seq,
+    const int& pivot, const int& window_size, const int& begin, const int& end,
+    StripedSmithWaterman::Alignment* al) {
+  int window_begin = 0;
+  const int8_t* window_seq = local_window_cache_.GetTranslatedSequence(
+      *reference_, stripe_sw_normal_, window_size, pivot, &window_begin);
+  if (window_seq == NULL)
+    stripe_sw.Align(read_seq.c_str(), GetSequence(begin, false), end - begin + 1, filter, al);
+  else
+    stripe_sw.Align(read_seq.c_str(), window_seq + (begin - window_begin), end - begin + 1, filter, al);
+}
+
 bool Aligner::SearchMediumIndel(const TargetRegion& target_region,
                                 const AlignmentFilter& alignment_filter,
                                 StripedSmithWaterman::Alignment* indel_al) {
 #ifdef VERBOSE_DEBUG
   fprintf(stderr, "=== Medium-sized INDELs alignment ===\n");
 #endif
-  namespace Constant = BamFlagConstant;
-  const bool is_anchor_mate1 = query_region_->pAnchor->core.flag & Constant::kBamFMate1;
-  const bool is_anchor_forward = !bam1_strand(query_region_->pAnchor);
-  search_region_type_.SetTechnologyAndAnchorMate1(technology_, is_anchor_mate1);
   SearchRegionType::RegionType region_type;
+  int pivot, begin, end;
+  if (!LoadLocalWindow(target_region, &region_type, &pivot, &begin, &end)) return false;
 
-  // ============================
-  // Get the standard region type
-  // ============================
-  search_region_type_.GetStandardType(is_anchor_forward, &region_type);
-
-  //fprintf(stderr, "%c%c%c\n", region_type.upstream?'T':'F', region_type.sequence_inverse?'T':'F', region_type.sequence_complement?'T':'F');
-
-  // ==============================================
-  // Calculate the pivot position and target region
-  // ==============================================
-  int anchor_pos = query_region_->pAnchor->core.pos;
-  int pivot = region_type.upstream ? anchor_pos + target_region.fragment_length
-                                   : anchor_pos - target_region.fragment_length;
-  if (pivot < 0) pivot = 0;
-
-  // Get the region according to the pivot and local_window_size
-  int begin, end;
-  bool special = false;
-  GetTargetRefRegion(target_region.local_window_size, pivot, special, &begin, &end);
-#ifdef VERBOSE_DEBUG
-  fprintf(stderr, "looking window: %d-%d\n", begin, end);
-#endif
-  if (end < begin) return false;
-
-  // =====================
-  // Get the read sequence
-  // =====================
-  SetTargetSequence(region_type, query_region_);
   string read_seq;
   read_seq.assign(query_region_->orphanSeq, query_region_->pOrphan->core.l_qseq);
 #ifdef VERBOSE_DEBUG
   fprintf(stderr, "%s\n", read_seq.c_str());
 #endif
 
+  SearchMemo::Key key;
+  SetSearchKey(SearchMemo::kMediumIndel, region_type, query_region_->pAnchor->core.tid,
+               begin, end, read_seq, &key);
+  bool found = false;
+  if (search_memo_.Get(key, &found, indel_al)) {
+    // Only the fields given by the anchor are set again
+    indel_al->is_reverse = region_type.sequence_inverse;
+    indel_al->is_complement = region_type.sequence_complement;
+    if (found) indel_al->ref_id = query_region_->pAnchor->core.tid;
+    return found;
+  }
+
+  found = AlignMediumIndel(target_region, alignment_filter, region_type, read_seq,
+                           pivot, begin, end, indel_al);
+  search_memo_.Put(key, found, *indel_al);
+  return found;
+}
+
+// @function: Aligns the orphan in query_region_ to the local window
+//            [begin, end] loaded by LoadLocalWindow and checks whether
+//            the alignment has a medium-sized indel.
+bool Aligner::AlignMediumIndel(const TargetRegion& target_region,
+                               const AlignmentFilter& alignment_filter,
+                               const SearchRegionType::RegionType& region_type,
+                               const string& read_seq,
+                               const int& pivot,
+                               int begin,
+                               const int& end,
+                               StripedSmithWaterman::Alignment* indel_al) {
   // =======================
   // Apply SSW to the region
   // =======================
-  int ref_length = end - begin + 1;
-  const char* ref_seq = GetSequence(begin, special);
-  assert(ref_seq != NULL);
+  assert(GetSequence(begin, false) != NULL);
   //fprintf(stderr, "%d\t%u\n", reference_->id, reference_->seqLen);
   //for (unsigned int i = 0; i < 10; ++i)
   //  fprintf(stderr, "%c", *(ref_seq+i));
@@ -788,7 +1357,10 @@ bool Aligner::SearchMediumIndel(const TargetRegion& target_region,
   // then we don't think that it's medium-sized indels and don't need to trace
   // the alignment.
   filter.distance_filter = read_seq.size() * 10;
-  stripe_sw_indel_.Align(read_seq.c_str(), ref_seq, ref_length, filter, indel_al);
+  if (target_region.split_indel_dp)
+    AlignSplitIndel(read_seq, pivot, target_region.local_window_size, begin, end, indel_al);
+  else
+    AlignLocalWindow(stripe_sw_indel_, filter, read_seq, pivot, target_region, end, &begin, indel_al);
   indel_al->is_reverse = region_type.sequence_inverse;
   indel_al->is_complement = region_type.sequence_complement;
   // Return false since no alignment is found
@@ -819,7 +1391,9 @@ bool Aligner::SearchMediumIndel(const TargetRegion& target_region,
 #ifdef VERBOSE_DEBUG
     fprintf(stderr, "INDEL found: event length: %d\n", event_length);
 #endif
-    if (indel_al->cigar.size() > 7) {
+    if (target_region.split_indel_dp) {
+      return AlignmentFilterApplication::PassMismatchFilter(*indel_al, alignment_filter, event_length);
+    } else if (indel_al->cigar.size() > 7) {
       AlignmentFilterApplication::TrimAlignment(alignment_filter, indel_al);
 #ifdef VERBOSE_DEBUG
       fprintf(stderr, "After trimming: end_pos,begin_pos,query_end,query_begin,mismatches,cigar\n");
@@ -841,10 +1415,105 @@ bool Aligner::SearchMediumIndel(const TargetRegion& target_region,
 
 }
 
+// @function: Aligns the orphan in query_region_ to the junctions of the
+//            medium-sized indels found before in its local window.
+// @return    True if it aligns across one of the junctions without gaps
+//            and passes the filters of medium-sized indels; indel_al is
+//            then set as SearchMediumIndel sets it.
+bool Aligner::SearchJunction(const TargetRegion& target_region,
+                             const AlignmentFilter& alignment_filter,
+                             StripedSmithWaterman::Alignment* indel_al) {
+  SearchRegionType::RegionType region_type;
+  int pivot, begin, end;
+  if (!LoadLocalWindow(target_region, &region_type, &pivot, &begin, &end)) return false;
+
+  vector<const JunctionCache::Junction*> junctions;
+  junction_cache_.Get(query_region_->pAnchor->core.tid, begin, end, &junctions);
+  if (junctions.empty()) return false;
+
+  string read_seq;
+  read_seq.assign(query_region_->orphanSeq, query_region_->pOrphan->core.l_qseq);
+  const int read_length = read_seq.size();
+  // Scored as SearchMediumIndel scores, so the flanks are clipped alike
+  vector<int8_t> read(read_length);
+  stripe_sw_indel_.Translate(read_seq.c_str(), read_length, &read[0]);
+  const int match    = stripe_sw_indel_.GetMatchScore();
+  const int mismatch = stripe_sw_indel_.GetMismatchPenalty();
+  const int min_flank = floor(read_length * alignment_filter.aligned_base_rate) + 1;
+  vector<int32_t> read_seeds;
+  JunctionCache::GetSeeds(&read[0], read_length, &read_seeds);
+  vector<int> diagonals;
+
+  namespace filter_app = AlignmentFilterApplication;
+  for (unsigned int i = 0; i < junctions.size(); ++i) {
+    const JunctionCache::Junction& junction = *junctions[i];
+    StripedSmithWaterman::Alignment al;
+    JunctionCache::GetDiagonals(junction, read_seeds, &diagonals);
+    if (!AlignJunction(read, junction, diagonals, match, mismatch, min_flank, &al)) continue;
+
+    unsigned int cigar_id = 0;
+    if (!FindMediumIndel(al, &cigar_id)) continue;
+    if (!DetermineMediumIndelBreakpoint(al, cigar_id, alignment_filter, read_length)) continue;
+    if (!filter_app::PassMismatchFilter(al, alignment_filter, junction.length)) continue;
+
+    *indel_al = al;
+    indel_al->ref_id        = query_region_->pAnchor->core.tid;
+    indel_al->is_reverse    = region_type.sequence_inverse;
+    indel_al->is_complement = region_type.sequence_complement;
+    return true;
+  }
+
+  return false;
+}
+
+// @function: Keeps the junction of the medium-sized indel of indel_al,
+//            which is aligned for read_seq by SearchMediumIndel. The
+//            junction has one read length of reference on each side.
+void Aligner::AddJunction(const StripedSmithWaterman::Alignment& indel_al,
+                          const string& read_seq) {
+  unsigned int cigar_id = 0;
+  if (!FindMediumIndel(indel_al, &cigar_id)) return;
+
+  int ref_pos = indel_al.ref_begin, query_pos = 0;
+  for (unsigned int i = 0; i < cigar_id; ++i) {
+    const uint8_t op = indel_al.cigar[i] & 0x0f;
+    const int length = indel_al.cigar[i] >> 4;
+    if (op == 0 || op == 2) ref_pos += length;                // M, D
+    if (op == 0 || op == 1 || op == 4) query_pos += length;   // M, I, S
+  }
+
+  JunctionCache::Junction junction;
+  junction.ref_id    = indel_al.ref_id;
+  junction.position  = ref_pos;
+  junction.insertion = (indel_al.cigar[cigar_id] & 0x0f) == 1;
+  junction.length    = indel_al.cigar[cigar_id] >> 4;
+
+  // The flanks are clipped to the loaded reference
+  const int flank   = read_seq.size();
+  const int lowest  = reference_->seqBegin;
+  const int highest = lowest + static_cast<int>(reference_->seqLen) - 1;
+  const int right_begin = junction.insertion ? ref_pos : ref_pos + junction.length;
+  const int right_end   = std::min(highest, right_begin + flank - 1);
+  junction.begin = std::max(lowest, ref_pos - flank);
+  if (junction.begin >= ref_pos || right_end < right_begin) return;
+
+  junction.sequence.assign(GetSequence(junction.begin, false), ref_pos - junction.begin);
+  if (junction.insertion) junction.sequence.append(read_seq, query_pos, junction.length);
+  junction.sequence.append(GetSequence(right_begin, false), right_end - right_begin + 1);
+  junction.translated.resize(junction.sequence.size());
+  stripe_sw_indel_.Translate(junction.sequence.c_str(), junction.sequence.size(),
+                             &junction.translated[0]);
+  junction_cache_.Add(junction);
+}
+
+inline int Aligner::GetLocalHashSize() const {
+  return (hash_table_ != NULL) ? hash_table_->hashSize : kDefaultLocalHashSize;
+}
+
 inline const char* Aligner::GetSequence(const size_t& start, const bool& special) const {
   if (special)
     return (reference_special_->sequence + start);
   else
-    return (reference_->sequence + start);
+    return (reference_->sequence + (start - reference_->seqBegin));
 }
 } //namespace
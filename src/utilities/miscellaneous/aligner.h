@@ -1,20 +1,29 @@
 #ifndef _ALIGNER_H_
 #define _ALIGNER_H_
 
+#include <string>
+
 extern "C" {
 #include "dataStructures/SR_QueryRegion.h"
 #include "outsources/samtools/bam.h"
 #include "utilities/bam/SR_BamInStream.h"
 #include "utilities/hashTable/SR_HashRegionTable.h"
 #include "utilities/hashTable/SR_InHashTable.h"
+#include "utilities/hashTable/SR_KmerFilter.h"
 #include "utilities/hashTable/SR_Reference.h"
 }
 
 #include "dataStructures/anchor_region.h"
 #include "dataStructures/search_region_type.h"
 #include "dataStructures/technology.h"
+#include "utilities/miscellaneous/junction_cache.h"
+#include "utilities/miscellaneous/local_window_cache.h"
+#include "utilities/miscellaneous/search_memo.h"
+#include "utilities/miscellaneous/split_indel_aligner.h"
 #include "utilities/smithwaterman/ssw_cpp.h"
 
+using std::string;
+
 namespace Scissors {
 
 struct Alignment;
@@ -25,6 +34,17 @@ class HashesCollection;
 
 class Aligner {
  public:
+  // Numbers of the special-reference searches that Align skips
+  struct CascadeSkips {
+    unsigned int after_indel;  // a decisive medium-sized indel is found
+    unsigned int after_local;  // a decisive first partial is found
+
+    CascadeSkips()
+        : after_indel(0)
+        , after_local(0)
+    {}
+  };
+
   Aligner();
   Aligner(const SR_Reference*   reference, 
           const SR_InHashTable* hash_table,
@@ -117,6 +137,12 @@ class Aligner {
                                     const uint8_t& mismatch_penalty      = 2,
 	                            const uint8_t& gap_opening_penalty   = 3,
 		                    const uint8_t& gap_extending_penalty = 1);
+  const CascadeSkips& GetCascadeSkips(void) const {return cascade_skips_;};
+
+  // @function:
+  //     Gets the number of orphan hashes that hit a hash masked by the
+  //     occurrence cap since the aligner was built
+  uint64_t GetMaskedSeedCount(void) const;
  private:
   SearchRegionType search_region_type_;
   AnchorRegion     anchor_region_;
@@ -130,17 +156,37 @@ class Aligner {
   SR_QueryRegion*       query_region_;
   HashRegionTable*      hashes_;
   HashRegionTable*      hashes_special_;
+  // The inverted orphan, seeded along with hashes_special_ when
+  //  seed_special_inversion_ is set; special_inversion_seeded_ tells
+  //  that it holds the orphan in query_region_
+  HashRegionTable*      hashes_special_inv_;
+  bool                  seed_special_inversion_;
+  bool                  special_inversion_seeded_;
   SR_SearchArgs         hash_length_;
   SR_RefView*           special_ref_view_;
+  LocalWindowCache      local_window_cache_;
+  SearchMemo            search_memo_;
+  JunctionCache         junction_cache_;
+  CascadeSkips          cascade_skips_;
+  vector<int8_t>        translated_special_;   // built by SetSpecialReference
+  SR_KmerFilter*        special_kmer_filter_;  // loaded by SetSpecialReference
+  SplitIndelAligner     split_indel_aligner_;
 
   StripedSmithWaterman::Aligner stripe_sw_indel_;
   StripedSmithWaterman::Aligner stripe_sw_normal_;
 
   void LoadRegionType(const bam1_t& anchor);
   const char* GetSequence(const size_t& start, const bool& special) const;
+  void SetSpecialReference(const SR_Reference* reference_special,
+                           const SR_InHashTable* hash_table_special);
+  int GetLocalHashSize() const;
   bool GetAlignment(const HashesCollection& hashes_collection, 
                     const unsigned int& id, const bool& special, const int& read_length,
-                    const char* read_seq, StripedSmithWaterman::Alignment* al);
+                    const char* read_seq, const StripedSmithWaterman::Filter& filter,
+                    StripedSmithWaterman::Alignment* al);
+  void SetPassingScoreFilter(const AlignmentFilter& alignment_filter,
+                             const string& read_seq,
+                             StripedSmithWaterman::Filter* filter) const;
   void GetTargetRefRegion(const int& extend_length, const int& hash_begin,
                           const bool& special, int* begin, int* end);
   void Align(const TargetEvent& target_event,
@@ -150,19 +196,90 @@ class Aligner {
 	     const bool& output_complete_bam,
 	     vector<bam1_t*>* alignments,
 	     vector<bam1_t*>* alignments_anchor);
+  bool LoadLocalWindow(const TargetRegion& target_region,
+                       SearchRegionType::RegionType* region_type,
+                       int* pivot,
+                       int* begin,
+                       int* end);
   bool SearchLocalPartial(const TargetRegion& target_region,
                           const AlignmentFilter& alignment_filter,
 			  StripedSmithWaterman::Alignment* local_al);
   bool SearchSpecialReference(const TargetRegion& target_region,
                               const AlignmentFilter& alignment_filter,
 			      const bool& inversive,
+			      const bool& seed_inversion,
 			      StripedSmithWaterman::Alignment* special_al);
+  bool NeedsSpecialSeeds(const SearchMemo::Search& search,
+                         const SearchRegionType::RegionType& region_type);
   bool SearchMediumIndel(const TargetRegion& target_region,
                          const AlignmentFilter& alignment_filter,
                          StripedSmithWaterman::Alignment* ssw_al);
+  bool SearchJunction(const TargetRegion& target_region,
+                      const AlignmentFilter& alignment_filter,
+                      StripedSmithWaterman::Alignment* indel_al);
+  void AddJunction(const StripedSmithWaterman::Alignment& indel_al,
+                   const string& read_seq);
+  bool AlignLocalPartial(const TargetRegion& target_region,
+                         const AlignmentFilter& alignment_filter,
+                         const SearchRegionType::RegionType& region_type,
+                         const string& read_seq,
+                         const int& pivot,
+                         int begin,
+                         const int& end,
+                         StripedSmithWaterman::Alignment* local_al);
+  bool AlignSpecialReference(const AlignmentFilter& alignment_filter,
+                             const SearchRegionType::RegionType& region_type,
+                             const string& read_seq,
+                             StripedSmithWaterman::Alignment* special_al);
+  bool AlignMediumIndel(const TargetRegion& target_region,
+                        const AlignmentFilter& alignment_filter,
+                        const SearchRegionType::RegionType& region_type,
+                        const string& read_seq,
+                        const int& pivot,
+                        int begin,
+                        const int& end,
+                        StripedSmithWaterman::Alignment* indel_al);
   bool LoadHashes(const bool& special, 
                   const int& read_length, 
                   HashesCollection* hashes_collection);
+  bool LoadSpecialHashes(const int& read_length,
+                         HashesCollection* hashes_collection);
+  bool LoadLocalHashes(const int& pivot,
+                       const int& window_size,
+                       const int& begin,
+                       const int& end,
+                       const int& read_length,
+                       HashesCollection* hashes_collection,
+                       int* table_begin);
+  void AlignLocalWindow(const StripedSmithWaterman::Aligner& stripe_sw,
+                        const StripedSmithWaterman::Filter& filter,
+                        const string& read_seq,
+                        const int& pivot,
+                        const TargetRegion& target_region,
+                        const int& end,
+                        int* begin,
+                        StripedSmithWaterman::Alignment* al);
+  bool AlignUngapped(const TargetRegion& target_region,
+                     const AlignmentFilter& alignment_filter,
+                     const string& read_seq,
+                     const int& pivot,
+                     const int& begin,
+                     const int& end,
+                     StripedSmithWaterman::Alignment* al);
+  bool AlignSplitIndel(const string& read_seq,
+                       const int& pivot,
+                       const int& window_size,
+                       const int& begin,
+                       const int& end,
+                       StripedSmithWaterman::Alignment* al);
+  void AlignNormalReference(const StripedSmithWaterman::Aligner& stripe_sw,
+                            const StripedSmithWaterman::Filter& filter,
+                            const string& read_seq,
+                            const int& pivot,
+                            const int& window_size,
+                            const int& begin,
+                            const int& end,
+                            StripedSmithWaterman::Alignment* al);
 
   Aligner (const Aligner&);
   Aligner& operator= (const Aligner&);
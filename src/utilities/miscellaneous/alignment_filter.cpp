@@ -1,5 +1,6 @@
 #include "alignment_filter.h"
 
+#include <algorithm>
 #include <iostream>
 #include "dataStructures/alignment.h"
 #include "utilities/smithwaterman/ssw_cpp.h"
@@ -240,5 +241,34 @@ bool PassMismatchFilter(
   else return false;
 } //PassMismatchFilter
 
+int GetMinimumPassingScore(
+    const AlignmentFilter& filter,
+    const int& read_length,
+    const int& unknown_bases,
+    const int& match_score,
+    const int& mismatch_penalty,
+    const int& gap_opening_penalty,
+    const int& gap_extending_penalty) {
+  // A trimmed alignment of bases aligned read bases (M and I) passes only if
+  //  bases > aligned_base_threshold and its mismatches and indel bases are
+  //  fewer than allowed_mismatches; its SSW score is at most the one of the
+  //  whole alignment. Each mismatch or indel base costs at most a match
+  //  plus the largest penalty, and each unknown base costs a match.
+  const int aligned_base_threshold = floor(read_length * filter.aligned_base_rate);
+  const int gap_penalty = std::max(gap_opening_penalty, gap_extending_penalty);
+  const int error_penalty = match_score + std::max(mismatch_penalty, gap_penalty);
+  bool bounded = false;
+  int min_score = 0;
+  for (int bases = aligned_base_threshold + 1; bases <= read_length; ++bases) {
+    float allowed_mismatches = ceil(bases * filter.allowed_mismatch_rate);
+    const int score = match_score * (bases - unknown_bases)
+                    - error_penalty * (static_cast<int>(allowed_mismatches) - 1);
+    if (!bounded || score < min_score) min_score = score;
+    bounded = true;
+  }
+
+  return (bounded && min_score > 0) ? min_score : 0;
+} // GetMinimumPassingScore
+
 } //namespace AlignmentFilter
 } //namespaceScissors
@@ -39,6 +39,16 @@ void TrimAlignment(const AlignmentFilter& filter, Alignment* al);
 void TrimAlignment(const AlignmentFilter& filter, StripedSmithWaterman::Alignment* al);
 bool PassMismatchFilter( const StripedSmithWaterman::Alignment& ssw_al,
         const AlignmentFilter& alignment_filter, const int& event_length);
+// @function: Gets a lower bound of the SSW scores of the alignments that
+//            pass TrimAlignment, PassMismatchFilter (without events) and
+//            FilterByAlignedBaseThreshold. An alignment that scores less
+//            is rejected by them anyway, so it needs no traceback.
+// @param  unknown_bases The bases of the read that are not ACGT, which
+//                       score nothing in SSW but are not mismatches.
+// @return The bound; 0 if nothing can be told.
+int GetMinimumPassingScore(const AlignmentFilter& filter, const int& read_length,
+        const int& unknown_bases, const int& match_score, const int& mismatch_penalty,
+        const int& gap_opening_penalty, const int& gap_extending_penalty);
 
 inline bool FilterByMismatch(const AlignmentFilter& filter, const Alignment& al);
 
@@ -27,6 +27,11 @@ void HashesCollection::Init(const BestRegionArray& array) {
     hash_regions_[i] = &array.data[i];
 }
 
+void HashesCollection::Init(BestRegion* const* regions, const unsigned int& size) {
+  hash_regions_.assign(regions, regions + size);
+  reverse(hash_regions_.begin(), hash_regions_.end());
+}
+
 void HashesCollection::SortByLength() {
   sort(hash_regions_.begin(), hash_regions_.end(), OperatorLength);
 }
@@ -15,6 +15,9 @@ class HashesCollection {
   HashesCollection(){};
   ~HashesCollection(){};
   void Init(const BestRegionArray& array);
+  // @function: Collects the regions that are already ordered longest first;
+  //            they are stored shortest first like after SortByLength.
+  void Init(BestRegion* const* regions, const unsigned int& size);
   void SortByLength(void);
   void Print(void)const;
   const BestRegion* Get (const unsigned int& index) const;
@@ -0,0 +1,85 @@
+#include "junction_cache.h"
+
+#include <algorithm>
+
+namespace Scissors {
+namespace {
+bool BreakpointLess(const JunctionCache::Junction& junction, const int& position) {
+  return junction.position < position;
+}
+} // unnamed namespace
+
+JunctionCache::JunctionCache()
+    : junctions_()
+    , size_(0) {
+}
+
+void JunctionCache::Clear(void) {
+  junctions_.clear();
+  size_ = 0;
+}
+
+bool JunctionCache::Add(const Junction& junction) {
+  vector<Junction>& junctions = junctions_[junction.ref_id];
+  vector<Junction>::iterator ite = std::lower_bound(junctions.begin(), junctions.end(),
+                                                    junction.position, BreakpointLess);
+  for (vector<Junction>::iterator same = ite;
+       same != junctions.end() && same->position == junction.position; ++same) {
+    if (same->insertion == junction.insertion && same->length == junction.length
+        && same->sequence == junction.sequence)
+      return false;
+  }
+
+  ite = junctions.insert(ite, junction);
+  vector<int32_t> seeds;
+  GetSeeds(&ite->translated[0], ite->translated.size(), &seeds);
+  for (unsigned int i = 0; i < seeds.size(); ++i)
+    if (seeds[i] >= 0)
+      ite->seeds.push_back(static_cast<uint64_t>(seeds[i]) << 32 | i);
+  std::sort(ite->seeds.begin(), ite->seeds.end());
+  ++size_;
+  return true;
+}
+
+void JunctionCache::GetSeeds(const int8_t* translated, const int& length,
+                             vector<int32_t>* seeds) {
+  seeds->assign(length >= kSeedSize ? length - kSeedSize + 1 : 0, -1);
+  int32_t seed = 0;
+  int last_n = -1;  // the last N seen
+  const int32_t mask = (1 << (2 * kSeedSize)) - 1;
+  for (int i = 0; i < length; ++i) {
+    if (translated[i] > 3) last_n = i;
+    seed = ((seed << 2) | (translated[i] & 3)) & mask;
+    if (i >= kSeedSize - 1 && last_n <= i - kSeedSize)
+      (*seeds)[i - kSeedSize + 1] = seed;
+  }
+}
+
+void JunctionCache::GetDiagonals(const Junction& junction, const vector<int32_t>& read_seeds,
+                                 vector<int>* diagonals) {
+  diagonals->clear();
+  for (unsigned int i = 0; i < read_seeds.size(); ++i) {
+    if (read_seeds[i] < 0) continue;
+    const uint64_t low = static_cast<uint64_t>(read_seeds[i]) << 32;
+    for (vector<uint64_t>::const_iterator ite = std::lower_bound(junction.seeds.begin(),
+             junction.seeds.end(), low);
+         ite != junction.seeds.end() && (*ite >> 32) == static_cast<uint64_t>(read_seeds[i]); ++ite)
+      diagonals->push_back(static_cast<int>(*ite & 0xffffffff) - static_cast<int>(i));
+  }
+  std::sort(diagonals->begin(), diagonals->end());
+  diagonals->erase(std::unique(diagonals->begin(), diagonals->end()), diagonals->end());
+}
+
+void JunctionCache::Get(const int32_t& ref_id, const int& begin, const int& end,
+                        vector<const Junction*>* junctions) const {
+  junctions->clear();
+  map<int32_t, vector<Junction> >::const_iterator chromosome = junctions_.find(ref_id);
+  if (chromosome == junctions_.end()) return;
+
+  const vector<Junction>& kept = chromosome->second;
+  for (vector<Junction>::const_iterator ite = std::lower_bound(kept.begin(), kept.end(),
+                                                               begin, BreakpointLess);
+       ite != kept.end() && ite->position <= end; ++ite)
+    junctions->push_back(&*ite);
+}
+} // namespace Scissors
@@ -0,0 +1,70 @@
+#ifndef UTILITIES_MISCELLANEOUS_JUNCTION_CACHE_H_
+#define UTILITIES_MISCELLANEOUS_JUNCTION_CACHE_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using std::map;
+using std::string;
+using std::vector;
+
+namespace Scissors {
+// Junctions of the medium-sized indels found so far, kept per chromosome.
+//  The sequence of a junction is the reference before the breakpoint, the
+//  inserted bases and the reference after the deleted ones, so an orphan
+//  from the same event aligns to it without gaps.
+class JunctionCache {
+ public:
+  struct Junction {
+    int32_t ref_id;
+    int     begin;      // the chromosome position of sequence[0]
+    int     position;   // the breakpoint: the first base after the event
+                        //  for insertions, the first deleted base for deletions
+    bool    insertion;
+    int     length;     // inserted or deleted bases
+    string  sequence;
+    vector<int8_t> translated;  // sequence translated for SSW
+    vector<uint64_t> seeds;     // seed << 32 | position, sorted; set by Add
+  };
+
+  // Length of the seeds that choose the diagonals to align
+  static const int kSeedSize = 12;
+
+  JunctionCache();
+
+  // @function: Drops all the junctions.
+  void Clear(void);
+
+  // @function: Keeps a junction.
+  // @return False if the same junction is kept already.
+  bool Add(const Junction& junction);
+
+  // @function: Gets the junctions of ref_id whose breakpoints are
+  //            in [begin, end].
+  void Get(const int32_t& ref_id, const int& begin, const int& end,
+           vector<const Junction*>* junctions) const;
+
+  // @function: Packs the seeds of a translated sequence.
+  // @param  seeds seeds[i] is the seed that begins at i; -1 if it has an N.
+  static void GetSeeds(const int8_t* translated, const int& length, vector<int32_t>* seeds);
+
+  // @function: Gets the diagonals on which the read of read_seeds, as
+  //            GetSeeds gives them, shares a seed with junction; the base
+  //            i of the read is on the base i + diagonal of junction.
+  static void GetDiagonals(const Junction& junction, const vector<int32_t>& read_seeds,
+                           vector<int>* diagonals);
+
+  unsigned int GetSize(void) const {return size_;};
+
+ private:
+  // sorted by breakpoint
+  map<int32_t, vector<Junction> > junctions_;
+  unsigned int size_;
+
+  JunctionCache (const JunctionCache&);
+  JunctionCache& operator= (const JunctionCache&);
+}; // JunctionCache
+} // namespace Scissors
+#endif // UTILITIES_MISCELLANEOUS_JUNCTION_CACHE_H_
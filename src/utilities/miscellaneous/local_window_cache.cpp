@@ -0,0 +1,107 @@
+#include "local_window_cache.h"
+
+namespace Scissors {
+
+LocalWindowCache::LocalWindowCache(const unsigned int& capacity)
+    : capacity_(capacity > 0 ? capacity : 1)
+    , clock_(0)
+    , build_count_(0)
+    , entries_() {
+  entries_.reserve(capacity_);
+}
+
+LocalWindowCache::~LocalWindowCache() {
+  Clear();
+}
+
+void LocalWindowCache::Clear(void) {
+  for (unsigned int i = 0; i < entries_.size(); ++i)
+    SR_InHashTableFree(entries_[i].table);
+  entries_.clear();
+}
+
+LocalWindowCache::Entry* LocalWindowCache::GetEntry(const SR_Reference& reference,
+    const int& window_size, const int& pivot) {
+  ++clock_;
+  const int tile = pivot / window_size;
+  for (unsigned int i = 0; i < entries_.size(); ++i) {
+    Entry& entry = entries_[i];
+    if (entry.tile == tile && entry.window_size == window_size
+        && entry.ref_id == reference.id && entry.seq_begin == reference.seqBegin) {
+      entry.last_use = clock_;
+      return &entry;
+    }
+  }
+
+  // Take a new slot or the least recently used one
+  Entry* entry = NULL;
+  if (entries_.size() < capacity_) {
+    entries_.push_back(Entry());
+    entry = &entries_.back();
+    entry->table = NULL;
+  } else {
+    entry = &entries_[0];
+    for (unsigned int i = 1; i < entries_.size(); ++i)
+      if (entries_[i].last_use < entry->last_use) entry = &entries_[i];
+  }
+
+  // The tile and one window on each side, clipped to the loaded slice
+  const int lowest  = reference.seqBegin;
+  const int highest = lowest + static_cast<int>(reference.seqLen) - 1;
+  int begin = tile * window_size - window_size;
+  if (begin < lowest) begin = lowest;
+  int end = tile * window_size + 2 * window_size - 1;
+  if (end > highest) end = highest;
+
+  entry->ref_id           = reference.id;
+  entry->seq_begin        = reference.seqBegin;
+  entry->window_size      = window_size;
+  entry->tile             = tile;
+  entry->begin            = begin;
+  entry->length           = end >= begin ? end - begin + 1 : 0;
+  entry->last_use         = clock_;
+  entry->table_built      = false;
+  entry->translated_built = false;
+
+  return entry;
+}
+
+const SR_InHashTable* LocalWindowCache::GetHashTable(const SR_Reference& reference,
+    const int& hash_size, const int& window_size, const int& pivot, int* window_begin) {
+  if (window_size <= 0) return NULL;
+
+  Entry* entry = GetEntry(reference, window_size, pivot);
+  if (!entry->table_built || entry->table->hashSize != hash_size) {
+    if (entry->table == NULL || entry->table->hashSize != hash_size) {
+      SR_InHashTableFree(entry->table);
+      entry->table = SR_InHashTableAllocSorted(hash_size);
+    }
+
+    SR_InHashTableLoad(entry->table, reference.sequence + (entry->begin - reference.seqBegin),
+                       entry->length, reference.id, 1);
+    entry->table_built = true;
+    ++build_count_;
+  }
+
+  *window_begin = entry->begin;
+  return entry->table;
+}
+
+const int8_t* LocalWindowCache::GetTranslatedSequence(const SR_Reference& reference,
+    const StripedSmithWaterman::Aligner& translator,
+    const int& window_size, const int& pivot, int* window_begin) {
+  if (window_size <= 0) return NULL;
+
+  Entry* entry = GetEntry(reference, window_size, pivot);
+  if (!entry->translated_built) {
+    // keep one byte so that the address is valid for an empty window
+    entry->translated.resize(entry->length + 1);
+    translator.Translate(reference.sequence + (entry->begin - reference.seqBegin),
+                         entry->length, &entry->translated[0]);
+    entry->translated_built = true;
+  }
+
+  *window_begin = entry->begin;
+  return &entry->translated[0];
+}
+} // namespace Scissors
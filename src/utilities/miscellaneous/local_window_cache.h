@@ -0,0 +1,78 @@
+#ifndef UTILITIES_MISCELLANEOUS_LOCAL_WINDOW_CACHE_H_
+#define UTILITIES_MISCELLANEOUS_LOCAL_WINDOW_CACHE_H_
+
+#include <vector>
+
+extern "C" {
+#include "utilities/hashTable/SR_InHashTable.h"
+#include "utilities/hashTable/SR_Reference.h"
+}
+
+#include "utilities/smithwaterman/ssw_cpp.h"
+
+using std::vector;
+
+namespace Scissors {
+// Data of reference windows that are searched by many orphans: a small
+//  hash table and the sequence translated for SSW. The reference is cut
+//  into tiles of window_size; the window of a tile covers the tile and
+//  one window_size on each side, so it holds [pivot - window_size,
+//  pivot + window_size] for every pivot in the tile. Each part of a
+//  window is built the first time it is asked for, and the least recently
+//  used window is replaced when a new tile is needed and the cache is full.
+class LocalWindowCache {
+ public:
+  LocalWindowCache(const unsigned int& capacity = 8);
+  ~LocalWindowCache();
+
+  // @function: Drops all the cached windows; call it when the content
+  //            of the reference changes.
+  void Clear(void);
+
+  // @function: Gets the hash table of the window that holds pivot.
+  // @param  reference    The (possibly sliced) reference
+  // @param  hash_size    Size of hashes in the table
+  // @param  window_size  Half width of the windows searched around pivots
+  // @param  pivot        A chromosome position in the loaded slice
+  // @param  window_begin The chromosome position of hash position 0 in the table
+  // @return The table; NULL if window_size is not positive
+  const SR_InHashTable* GetHashTable(const SR_Reference& reference, const int& hash_size,
+                                     const int& window_size, const int& pivot, int* window_begin);
+
+  // @function: Gets the sequence of the window that holds pivot, translated
+  //            by the given SSW aligner.
+  // @param  window_begin The chromosome position of the first translated base
+  // @return The translated sequence; NULL if window_size is not positive
+  const int8_t* GetTranslatedSequence(const SR_Reference& reference,
+                                      const StripedSmithWaterman::Aligner& translator,
+                                      const int& window_size, const int& pivot, int* window_begin);
+
+  unsigned int GetBuildCount(void) const {return build_count_;};
+
+ private:
+  struct Entry {
+    int32_t  ref_id;
+    uint32_t seq_begin;
+    int      window_size;
+    int      tile;
+    int      begin;
+    int      length;
+    unsigned int last_use;
+    bool     table_built;
+    SR_InHashTable* table;
+    bool     translated_built;
+    vector<int8_t> translated;
+  };
+
+  unsigned int  capacity_;
+  unsigned int  clock_;
+  unsigned int  build_count_;
+  vector<Entry> entries_;
+
+  Entry* GetEntry(const SR_Reference& reference, const int& window_size, const int& pivot);
+
+  LocalWindowCache (const LocalWindowCache&);
+  LocalWindowCache& operator= (const LocalWindowCache&);
+}; // LocalWindowCache
+} // namespace Scissors
+#endif // UTILITIES_MISCELLANEOUS_LOCAL_WINDOW_CACHE_H_
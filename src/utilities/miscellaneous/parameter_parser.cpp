@@ -59,6 +59,16 @@ void ParseArgumentsOrDie(const int argc, char* const * argv,
 		{"not-medium-sized-indel", no_argument, NULL, 5},
 		{"not-special-insertion-inversion", no_argument, NULL, 7},
 		{"technology", required_argument, NULL, 't'},
+		{"minimizer-window", required_argument, NULL, 8},
+		{"hash-size", required_argument, NULL, 9},
+		{"special-hash-size", required_argument, NULL, 10},
+		{"max-hash-occurrence", required_argument, NULL, 11},
+		{"local-seed-band", required_argument, NULL, 12},
+		{"ungapped-xdrop", required_argument, NULL, 13},
+		{"split-indel-dp", no_argument, NULL, 14},
+		{"junction-cache", no_argument, NULL, 15},
+		{"decisive-indel-rate", required_argument, NULL, 16},
+		{"decisive-local-rate", required_argument, NULL, 17},
 
 		// original bam alignment filters
 		{"mapping-quality-threshold", no_argument, NULL, 'Q'},
@@ -144,6 +154,44 @@ void ParseArgumentsOrDie(const int argc, char* const * argv,
 			case 't': 
 			        Convert_Technology(optarg, &(param->technology));
 			        break;
+			case 8:
+				if (!convert_from_string(optarg, param->minimizer_window))
+					cerr << "WARNING: Cannot parse the argument of --minimizer-window." << endl;
+				break;
+			case 9:
+				if (!convert_from_string(optarg, param->hash_size))
+					cerr << "WARNING: Cannot parse the argument of --hash-size." << endl;
+				break;
+			case 10:
+				if (!convert_from_string(optarg, param->special_hash_size))
+					cerr << "WARNING: Cannot parse the argument of --special-hash-size." << endl;
+				break;
+			case 11:
+				if (!convert_from_string(optarg, param->max_hash_occurrence))
+					cerr << "WARNING: Cannot parse the argument of --max-hash-occurrence." << endl;
+				break;
+			case 12:
+				if (!convert_from_string(optarg, param->local_seed_band))
+					cerr << "WARNING: Cannot parse the argument of --local-seed-band." << endl;
+				break;
+			case 13:
+				if (!convert_from_string(optarg, param->ungapped_xdrop))
+					cerr << "WARNING: Cannot parse the argument of --ungapped-xdrop." << endl;
+				break;
+			case 14:
+				param->split_indel_dp = true;
+				break;
+			case 15:
+				param->junction_cache = true;
+				break;
+			case 16:
+				if (!convert_from_string(optarg, param->decisive_indel_rate))
+					cerr << "WARNING: Cannot parse the argument of --decisive-indel-rate." << endl;
+				break;
+			case 17:
+				if (!convert_from_string(optarg, param->decisive_local_rate))
+					cerr << "WARNING: Cannot parse the argument of --decisive-local-rate." << endl;
+				break;
 
 			// original bam alignment filters
 			case 'Q':
@@ -251,6 +299,46 @@ bool CheckParameters(Parameters* param) {
          << "         Set it to default, 1000." << endl;
   }
 
+  if ((param->minimizer_window < 1) || (param->minimizer_window > 255)) {
+    cerr << "WARNING: --minimizer-window should be in [1 - 255]. Set it to default, 1." << endl;
+    param->minimizer_window = 1;
+  }
+
+  if ((param->hash_size < 1) || (param->hash_size > 31)) {
+    cerr << "WARNING: --hash-size should be in [1 - 31]. Set it to default, 7." << endl;
+    param->hash_size = 7;
+  }
+
+  if ((param->special_hash_size < 1) || (param->special_hash_size > 31)) {
+    cerr << "WARNING: --special-hash-size should be in [1 - 31]. Set it to default, 7." << endl;
+    param->special_hash_size = 7;
+  }
+
+  if (param->max_hash_occurrence < 0) {
+    cerr << "WARNING: --max-hash-occurrence should not be negative. Set it to default, 0." << endl;
+    param->max_hash_occurrence = 0;
+  }
+
+  if (param->local_seed_band < 0) {
+    cerr << "WARNING: --local-seed-band should not be negative. Set it to default, 0." << endl;
+    param->local_seed_band = 0;
+  }
+
+  if (param->ungapped_xdrop < 0) {
+    cerr << "WARNING: --ungapped-xdrop should not be negative. Set it to default, 0." << endl;
+    param->ungapped_xdrop = 0;
+  }
+
+  if ((param->decisive_indel_rate < 0.0) || (param->decisive_indel_rate > 1.0)) {
+    cerr << "WARNING: --decisive-indel-rate should be in [0.0 - 1.0]. Set it to default, 0.0." << endl;
+    param->decisive_indel_rate = 0.0;
+  }
+
+  if ((param->decisive_local_rate < 0.0) || (param->decisive_local_rate > 1.0)) {
+    cerr << "WARNING: --decisive-local-rate should be in [0.0 - 1.0]. Set it to default, 0.0." << endl;
+    param->decisive_local_rate = 0.0;
+  }
+
   if ((param->aligned_base_rate < 0.0) || (param->aligned_base_rate > 1.0)) {
     cerr << "WARNING: -B should be in [0.0 - 1.0]. Set it to default, 0.3." << endl;
     param->aligned_base_rate = 0.3;
@@ -355,6 +443,41 @@ void PrintLongHelp(const string& program) {
 		<< "   --not-special-insertion-inversion" << endl
 		<< "                         When -s is given, the default is on." << endl
 		<< "   -t --technology <STR> ILLUMINA, 454, or SOLID." << endl
+		<< "   --minimizer-window <INT>" << endl
+		<< "                         Only index (w,k)-minimizers of references; smaller" << endl
+		<< "                         hash tables but sparser seeds. 1 indexes every" << endl
+		<< "                         position. [1]" << endl
+		<< "   --hash-size <INT>     Hash size (1 - 31) of the reference hash table. Sizes" << endl
+		<< "                         above 12 use a sorted key directory. [7]" << endl
+		<< "   --special-hash-size <INT>" << endl
+		<< "                         Hash size (1 - 31) of the special reference hash" << endl
+		<< "                         table. [7]" << endl
+		<< "   --max-hash-occurrence <INT>" << endl
+		<< "                         Mask hashes occurring more than INT times in a refe-" << endl
+		<< "                         rence; 0 for no masking. [0]" << endl
+		<< "   --local-seed-band <INT>" << endl
+		<< "                         Align orphans only within INT bp around the diagonal" << endl
+		<< "                         of their longest seed in the mate window, instead of" << endl
+		<< "                         the whole window; 0 for whole windows. [0]" << endl
+		<< "   --ungapped-xdrop <INT>" << endl
+		<< "                         Extend the seeds of orphans in the mate window with-" << endl
+		<< "                         out gaps until the score drops INT below the best," << endl
+		<< "                         and skip Smith-Waterman when the extension passes" << endl
+		<< "                         the split-read filters; 0 for no extension. [0]" << endl
+		<< "   --split-indel-dp      Find medium-sized indels by joining two ungapped" << endl
+		<< "                         pieces of orphans at one gap, instead of by Smith-" << endl
+		<< "                         Waterman with huge-gap scores." << endl
+		<< "   --junction-cache      Align orphans to the junctions of the medium-sized" << endl
+		<< "                         indels found nearby first, and search the whole" << endl
+		<< "                         window only if none of them fits." << endl
+		<< "   --decisive-indel-rate <FLOAT>" << endl
+		<< "                         Skip the special reference searches of orphans whose" << endl
+		<< "                         medium-sized indel alignment aligns at least FLOAT" << endl
+		<< "                         of the bases; 0 never skips. [0.0]" << endl
+		<< "   --decisive-local-rate <FLOAT>" << endl
+		<< "                         Skip the special reference searches of orphans whose" << endl
+		<< "                         first partial aligns at least FLOAT of the bases;" << endl
+		<< "                         0 never skips. [0.0]" << endl
 		<< endl
 
 		<< "Original BAM alignments filters:" << endl
@@ -29,6 +29,26 @@ struct Parameters {
   bool  not_special_insertion_inversion; // --not-special-insertion-inversion
                                          // getopt returns 7
   Technology technology;        // -t --technology
+  int   minimizer_window;       // --minimizer-window
+                                // getopt returns 8
+  int   hash_size;              // --hash-size
+                                // getopt returns 9
+  int   special_hash_size;      // --special-hash-size
+                                // getopt returns 10
+  int   max_hash_occurrence;    // --max-hash-occurrence
+                                // getopt returns 11
+  int   local_seed_band;        // --local-seed-band
+                                // getopt returns 12
+  int   ungapped_xdrop;         // --ungapped-xdrop
+                                // getopt returns 13
+  bool  split_indel_dp;         // --split-indel-dp
+                                // getopt returns 14
+  bool  junction_cache;         // --junction-cache
+                                // getopt returns 15
+  float decisive_indel_rate;    // --decisive-indel-rate
+                                // getopt returns 16
+  float decisive_local_rate;    // --decisive-local-rate
+                                // getopt returns 17
 
   // original alignment filters
   int mapping_quality_threshold; // -Q --mapping-quality-threshold
@@ -65,6 +85,16 @@ struct Parameters {
       , not_medium_sized_indel(false)
       , not_special_insertion_inversion(false)
       , technology(TECH_NONE)
+      , minimizer_window(1)
+      , hash_size(7)
+      , special_hash_size(7)
+      , max_hash_occurrence(0)
+      , local_seed_band(0)
+      , ungapped_xdrop(0)
+      , split_indel_dp(false)
+      , junction_cache(false)
+      , decisive_indel_rate(0.0)
+      , decisive_local_rate(0.0)
       , mapping_quality_threshold(10)
       , allowed_clip(0.2)
       , region()
@@ -0,0 +1,71 @@
+#include "search_memo.h"
+
+namespace Scissors {
+
+SearchMemo::SearchMemo(const unsigned int& capacity)
+    : hit_count_(0)
+    , entries_(capacity > 0 ? capacity : 1) {
+  Clear();
+}
+
+void SearchMemo::Clear(void) {
+  for (unsigned int i = 0; i < entries_.size(); ++i)
+    entries_[i].used = false;
+}
+
+void SearchMemo::ClearNormal(void) {
+  for (unsigned int i = 0; i < entries_.size(); ++i)
+    if (entries_[i].key.search == kMediumIndel || entries_[i].key.search == kLocalPartial)
+      entries_[i].used = false;
+}
+
+// FNV-1a over the sequence and the window
+uint32_t SearchMemo::Hash(const Key& key) {
+  uint32_t hash = 2166136261u;
+  const uint32_t fields[] = {static_cast<uint32_t>(key.search),
+                             static_cast<uint32_t>(key.sequence_inverse) << 1
+                                 | static_cast<uint32_t>(key.sequence_complement),
+                             static_cast<uint32_t>(key.ref_id),
+                             static_cast<uint32_t>(key.begin),
+                             static_cast<uint32_t>(key.end)};
+  for (unsigned int i = 0; i < sizeof(fields) / sizeof(fields[0]); ++i) {
+    hash ^= fields[i];
+    hash *= 16777619u;
+  }
+  for (unsigned int i = 0; i < key.sequence.size(); ++i) {
+    hash ^= static_cast<unsigned char>(key.sequence[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+const SearchMemo::Entry* SearchMemo::Find(const Key& key, const uint32_t& hash) const {
+  const Entry& entry = entries_[hash % entries_.size()];
+  if (!entry.used || entry.hash != hash || !(entry.key == key)) return NULL;
+  return &entry;
+}
+
+bool SearchMemo::Get(const Key& key, bool* found, StripedSmithWaterman::Alignment* al) {
+  const Entry* entry = Find(key, Hash(key));
+  if (entry == NULL) return false;
+
+  *found = entry->found;
+  *al    = entry->al;
+  ++hit_count_;
+  return true;
+}
+
+bool SearchMemo::Has(const Key& key) const {
+  return Find(key, Hash(key)) != NULL;
+}
+
+void SearchMemo::Put(const Key& key, const bool& found, const StripedSmithWaterman::Alignment& al) {
+  const uint32_t hash = Hash(key);
+  Entry& entry = entries_[hash % entries_.size()];
+  entry.used  = true;
+  entry.hash  = hash;
+  entry.key   = key;
+  entry.found = found;
+  entry.al    = al;
+}
+} // namespace Scissors
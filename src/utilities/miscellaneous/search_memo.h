@@ -0,0 +1,92 @@
+#ifndef UTILITIES_MISCELLANEOUS_SEARCH_MEMO_H_
+#define UTILITIES_MISCELLANEOUS_SEARCH_MEMO_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "utilities/smithwaterman/ssw_cpp.h"
+
+using std::string;
+using std::vector;
+
+namespace Scissors {
+// Results of the searches of Aligner for orphans. Deep or PCR-heavy
+//  libraries have many orphans with the same sequence whose anchors give
+//  the same local window; such an orphan gets the result of the first one
+//  instead of being searched again. A result is kept in the slot chosen by
+//  the hash of its key and replaces the older result of the slot. The
+//  results depend on the filters of the search as well, which are the
+//  same for all the orphans aligned with a reference.
+class SearchMemo {
+ public:
+  enum Search {
+    kMediumIndel,
+    kLocalPartial,
+    kSpecial,
+    kSpecialInversion,
+  };
+
+  struct Key {
+    Search  search;
+    bool    sequence_inverse;    // the region type of the search
+    bool    sequence_complement;
+    int32_t ref_id;              // the window searched; -1 for the special
+    int     begin;               //  reference
+    int     end;
+    string  sequence;            // the orphan in the orientation searched
+
+    bool operator== (const Key& other) const {
+      return search == other.search
+          && sequence_inverse == other.sequence_inverse
+          && sequence_complement == other.sequence_complement
+          && ref_id == other.ref_id
+          && begin == other.begin && end == other.end
+          && sequence == other.sequence;
+    }
+  };
+
+  SearchMemo(const unsigned int& capacity = 4096);
+
+  // @function: Drops all the results; call it when the content
+  //            of the reference changes.
+  void Clear(void);
+
+  // @function: Drops the results of the searches in the normal reference;
+  //            call it when only the normal reference changes.
+  void ClearNormal(void);
+
+  // @function: Gets the result of key.
+  // @param  found Whether the search found an alignment
+  // @param  al    The alignment set by the search
+  // @return False if there is no result of key.
+  bool Get(const Key& key, bool* found, StripedSmithWaterman::Alignment* al);
+
+  // @function: Tells whether there is a result of key.
+  bool Has(const Key& key) const;
+
+  // @function: Keeps the result of key.
+  void Put(const Key& key, const bool& found, const StripedSmithWaterman::Alignment& al);
+
+  unsigned int GetHitCount(void) const {return hit_count_;};
+
+ private:
+  struct Entry {
+    bool     used;
+    uint32_t hash;
+    Key      key;
+    bool     found;
+    StripedSmithWaterman::Alignment al;
+  };
+
+  unsigned int  hit_count_;
+  vector<Entry> entries_;
+
+  static uint32_t Hash(const Key& key);
+  const Entry* Find(const Key& key, const uint32_t& hash) const;
+
+  SearchMemo (const SearchMemo&);
+  SearchMemo& operator= (const SearchMemo&);
+}; // SearchMemo
+} // namespace Scissors
+#endif // UTILITIES_MISCELLANEOUS_SEARCH_MEMO_H_
@@ -0,0 +1,184 @@
+#include "split_indel_aligner.h"
+
+#include <limits.h>
+#include <algorithm>
+#include <sstream>
+
+namespace Scissors {
+SplitIndelAligner::SplitIndelAligner()
+    : prefix_()
+    , suffix_() {
+}
+
+bool SplitIndelAligner::Align(const int8_t* read, const int& read_len,
+    const int8_t* ref, const int& ref_len, const int& match_score, const int& mismatch_penalty,
+    const int& gap_opening_penalty, const int& gap_extending_penalty,
+    const int& min_piece_length, StripedSmithWaterman::Alignment* al) {
+  al->Clear();
+  if (read_len < 2 || ref_len < 2) return false;
+
+  // Copied, since the matrices written below may alias the references,
+  //  which keeps the compiler from vectorizing the loops
+  const int read_length = read_len;
+  const int ref_length  = ref_len;
+  const int match       = match_score;
+  const int mismatch    = mismatch_penalty;
+  const int gap_open    = gap_opening_penalty;
+  const int gap_extend  = gap_extending_penalty;
+
+  // prefix[i * ref_length + j]: the best ungapped piece ending at read i and ref j;
+  // suffix[i * ref_length + j]: the best ungapped piece beginning there
+  prefix_.resize(read_length * ref_length);
+  suffix_.resize(read_length * ref_length);
+  int* prefix = &prefix_[0];
+  int* suffix = &suffix_[0];
+  // the scores of each base against the reference
+  vector<int> profile(5 * ref_length);
+  for (int base = 0; base < 5; ++base)
+    for (int j = 0; j < ref_length; ++j)
+      profile[base * ref_length + j] = (base == 4 || ref[j] == 4) ? 0 
+                                     : (base == ref[j] ? match : -mismatch);
+  // the best pieces in each row bound the joins at the row
+  vector<int> prefix_max(read_length, 0), suffix_max(read_length, 0);
+  for (int i = 0; i < read_length; ++i) {
+    int* row = prefix + i * ref_length;
+    const int* score = &profile[read[i] * ref_length];
+    row[0] = score[0];
+    if (i == 0) {
+      for (int j = 1; j < ref_length; ++j) row[j] = score[j];
+    } else {
+      const int* last = row - ref_length;
+      for (int j = 1; j < ref_length; ++j) row[j] = score[j] + std::max(last[j - 1], 0);
+    }
+    int row_max = 0;
+    for (int j = 0; j < ref_length; ++j) row_max = std::max(row_max, row[j]);
+    prefix_max[i] = row_max;
+  }
+  for (int i = read_length - 1; i >= 0; --i) {
+    int* row = suffix + i * ref_length;
+    const int* score = &profile[read[i] * ref_length];
+    row[ref_length - 1] = score[ref_length - 1];
+    if (i == read_length - 1) {
+      for (int j = 0; j < ref_length - 1; ++j) row[j] = score[j];
+    } else {
+      const int* next = row + ref_length;
+      for (int j = 0; j < ref_length - 1; ++j) row[j] = score[j] + std::max(next[j + 1], 0);
+    }
+    int row_max = 0;
+    for (int j = 0; j < ref_length; ++j) row_max = std::max(row_max, row[j]);
+    suffix_max[i] = row_max;
+  }
+  const int single_best = *std::max_element(prefix_max.begin(), prefix_max.end());
+
+  // A gap of length n costs gap_open + (n - 1) * gap_extend, so a left
+  //  piece is kept with the extensions that it saves. A row is skipped when
+  //  its best pieces cannot beat the best join so far; otherwise it is
+  //  scored without branches first, and the pieces of a join are only
+  //  looked for when the row beats the best join. A join of a piece that
+  //  scores nothing never beats the single best piece, so the pieces need
+  //  no check while scoring.
+  int best_score = single_best, best_row = -1, best_col = -1, best_gap = 0;
+  bool best_deletion = true;
+  vector<int> kept(ref_length);
+  // deletions: the left piece ends at (i, j), the right one begins at (i + 1, k), k > j + 1
+  for (int i = 0; i + 1 < read_length; ++i) {
+    const int* left  = prefix + i * ref_length;
+    const int* right = suffix + (i + 1) * ref_length;
+    if (prefix_max[i] + suffix_max[i + 1] - gap_open <= best_score) continue;
+    int running = INT_MIN / 2;
+    for (int k = 2; k < ref_length; ++k) {
+      running = std::max(running, left[k - 2] + (k - 2) * gap_extend);
+      kept[k] = running;
+    }
+    int row_best = INT_MIN / 2;
+    for (int k = 2; k < ref_length; ++k)
+      row_best = std::max(row_best, kept[k] + right[k] - (k - 2) * gap_extend);
+    row_best -= gap_open;
+    if (row_best <= best_score) continue;
+    int k = 2;
+    while (kept[k] + right[k] - (k - 2) * gap_extend - gap_open != row_best) ++k;
+    int j = 0;
+    while (left[j] + j * gap_extend != kept[k]) ++j;
+    best_score = row_best; best_row = i; best_col = j;
+    best_gap = k - j - 1; best_deletion = true;
+  }
+  // insertions: the left piece ends at (i, j), the right one begins at (k, j + 1), k > i + 1;
+  //  the best left pieces of all columns are kept while going down the rows
+  std::fill(kept.begin(), kept.end(), INT_MIN / 2);
+  int kept_rows = 0, left_max = 0;
+  for (int k = 2; k < read_length; ++k) {
+    left_max = std::max(left_max, prefix_max[k - 2]);
+    if (left_max + suffix_max[k] - gap_open <= best_score) continue;
+    // keep the left pieces of the rows up to k - 2
+    for (; kept_rows <= k - 2; ++kept_rows) {
+      const int* left = prefix + kept_rows * ref_length;
+      for (int j = 0; j + 1 < ref_length; ++j)
+        kept[j] = std::max(kept[j], left[j] + kept_rows * gap_extend);
+    }
+    const int* right = suffix + k * ref_length;
+    int row_best = INT_MIN / 2;
+    for (int j = 0; j + 1 < ref_length; ++j)
+      row_best = std::max(row_best, kept[j] + right[j + 1]);
+    row_best -= (k - 2) * gap_extend + gap_open;
+    if (row_best <= best_score) continue;
+    int j = 0;
+    while (kept[j] + right[j + 1] - (k - 2) * gap_extend - gap_open != row_best) ++j;
+    int row = 0;
+    while (prefix[row * ref_length + j] + row * gap_extend != kept[j]) ++row;
+    best_score = row_best; best_row = row; best_col = j;
+    best_gap = k - row - 1; best_deletion = false;
+  }
+  if (best_row < 0) return false;
+
+  // Walk the pieces back and forth from the gap
+  int left_row = best_row, left_col = best_col;
+  while (left_row > 0 && left_col > 0 && prefix[(left_row - 1) * ref_length + left_col - 1] > 0) {
+    --left_row;
+    --left_col;
+  }
+  int right_row = best_deletion ? best_row + 1 : best_row + best_gap + 1;
+  int right_col = best_deletion ? best_col + best_gap + 1 : best_col + 1;
+  const int right_begin_row = right_row, right_begin_col = right_col;
+  while (right_row < read_length - 1 && right_col < ref_length - 1
+         && suffix[(right_row + 1) * ref_length + right_col + 1] > 0) {
+    ++right_row;
+    ++right_col;
+  }
+  if (right_col - left_col > read_length * 10 || right_row - left_row > read_length * 10) return false;
+
+  const int left_length  = best_row - left_row + 1;
+  const int right_length = right_row - right_begin_row + 1;
+  if (std::min(left_length, right_length) < min_piece_length) return false;
+
+  al->sw_score          = best_score;
+  al->ref_begin         = left_col;
+  al->ref_end           = right_col;
+  al->query_begin       = left_row;
+  al->query_end         = right_row;
+  al->ref_end_next_best = -1;
+  for (int i = left_row; i <= best_row; ++i)
+    if (read[i] != ref[left_col + i - left_row]) ++al->mismatches;
+  for (int i = right_begin_row; i <= right_row; ++i)
+    if (read[i] != ref[right_begin_col + i - right_begin_row]) ++al->mismatches;
+  al->mismatches += best_gap;
+
+  const int end_clip     = read_length - right_row - 1;
+  std::ostringstream cigar_string;
+  if (left_row > 0) {
+    al->cigar.push_back((left_row << 4) | 0x04);
+    cigar_string << left_row << 'S';
+  }
+  al->cigar.push_back(left_length << 4);
+  al->cigar.push_back((best_gap << 4) | (best_deletion ? 0x02 : 0x01));
+  al->cigar.push_back(right_length << 4);
+  cigar_string << left_length << 'M' << best_gap << (best_deletion ? 'D' : 'I')
+               << right_length << 'M';
+  if (end_clip > 0) {
+    al->cigar.push_back((end_clip << 4) | 0x04);
+    cigar_string << end_clip << 'S';
+  }
+  al->cigar_string = cigar_string.str();
+
+  return true;
+}
+} // namespace Scissors
@@ -0,0 +1,50 @@
+#ifndef UTILITIES_MISCELLANEOUS_SPLIT_INDEL_ALIGNER_H_
+#define UTILITIES_MISCELLANEOUS_SPLIT_INDEL_ALIGNER_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "utilities/smithwaterman/ssw_cpp.h"
+
+using std::vector;
+
+namespace Scissors {
+// Aligns a read as two ungapped pieces joined by one deletion or insertion,
+//  as --split-indel-dp searches medium-sized indels. The matrices of the
+//  best pieces that end and that begin at each cell are filled once; the
+//  best join of them is then found by sweeping the rows, keeping the best
+//  left piece so far of each row for deletions and of each column for
+//  insertions. The sequences are translated as SSW translates them; N (4)
+//  scores nothing against any base.
+class SplitIndelAligner {
+ public:
+  SplitIndelAligner();
+
+  // @function: Aligns read to ref. The cigar is [S]M(D|I)M[S], i.e. the
+  //            breakpoint is the gap.
+  // @param  min_piece_length Pieces shorter than it are likely random hits.
+  // @param  al  The alignment with positions relative to ref; the cigar
+  //             is empty if no join scores more than a single piece, a
+  //             piece is shorter than min_piece_length, or the pieces
+  //             span more than ten read lengths as the distance filter
+  //             of SSW requires.
+  // @return True if a join is found.
+  bool Align(const int8_t* read, const int& read_length,
+             const int8_t* ref, const int& ref_length,
+             const int& match, const int& mismatch,
+             const int& gap_open, const int& gap_extend,
+             const int& min_piece_length,
+             StripedSmithWaterman::Alignment* al);
+
+ private:
+  // The DP matrices of read_length * ref_length cells, kept to be reused
+  //  by the next read; they grow to the largest read and window aligned.
+  vector<int> prefix_;  // the best ungapped pieces that end at each cell
+  vector<int> suffix_;  // the best ungapped pieces that begin at each cell
+
+  SplitIndelAligner (const SplitIndelAligner&);
+  SplitIndelAligner& operator= (const SplitIndelAligner&);
+}; // SplitIndelAligner
+} // namespace Scissors
+
+#endif // UTILITIES_MISCELLANEOUS_SPLIT_INDEL_ALIGNER_H_
@@ -34,6 +34,35 @@ inline void GetChromosomeId(const SR_BamListIter& alignment_list,
   //cerr << bam1_qname(&alignment_list->alignment) << endl;
 }
 
+// Reports how many hashes of a freshly loaded table are masked
+//  by the --max-hash-occurrence cap.
+void ReportMaskedHashes(const SR_InHashTable* hash_table, const char* name) {
+  if ((hash_table == NULL) || (hash_table->numMaskedHashes == 0)) return;
+  fprintf(stderr, "Masked %u hashes (%u positions) in %s.\n", 
+          hash_table->numMaskedHashes, hash_table->numMaskedPos, name);
+}
+
+// Reports the special-reference searches that the aligner of a thread
+//  skipped, when --decisive-indel-rate or --decisive-local-rate is given.
+void ReportCascadeSkips(const Aligner& aligner, const TargetRegion& target_region,
+                        const int& id) {
+  if ((target_region.decisive_indel_rate <= 0.0) && (target_region.decisive_local_rate <= 0.0))
+    return;
+  const Aligner::CascadeSkips& skips = aligner.GetCascadeSkips();
+  fprintf(stderr, "Thread %d skipped special searches: %u after decisive indels, "
+          "%u after decisive first partials.\n",
+          id, skips.after_indel, skips.after_local);
+}
+
+// Reports how many orphan hashes that the aligner of a thread seeded
+//  hit a hash masked by the --max-hash-occurrence cap.
+void ReportMaskedSeeds(const Aligner& aligner, const int& id) {
+  const uint64_t masked_seeds = aligner.GetMaskedSeedCount();
+  if (masked_seeds == 0) return;
+  fprintf(stderr, "Thread %d skipped %llu orphan hashes that are masked.\n",
+          id, static_cast<unsigned long long>(masked_seeds));
+}
+
 void StoreAlignmentInBam(const vector<bam1_t*>& alignments_bam,
                          const vector<bam1_t*>& alignments_anchor,
 			 bamFile* bam_writer,
@@ -159,6 +188,8 @@ void* RunThread (void* thread_data_) {
 
   } // end while
 
+  ReportMaskedSeeds(aligner, td->id);
+  ReportCascadeSkips(aligner, td->target_region, td->id);
   pthread_exit(NULL);
 }
 } //namespace
@@ -173,6 +204,7 @@ Thread::Thread(const BamReference*    bam_reference,
 	       const int&             bam_mq_threshold,
 	       const AlignmentFilter& alignment_filter,
 	       const TargetRegion&    target_region,
+	       const HashSetting&     hash_setting,
 	       const string           special_fasta,
 	       FastaReference*        ref_reader,
 	       SR_BamInStream*        bam_reader,
@@ -187,6 +219,7 @@ Thread::Thread(const BamReference*    bam_reference,
     , bam_mq_threshold_(bam_mq_threshold)
     , alignment_filter_(alignment_filter)
     , target_region_(target_region)
+    , hash_setting_(hash_setting)
     , special_fasta_(special_fasta)
     , ref_reader_(ref_reader)
     , bam_reader_(bam_reader)
@@ -204,15 +237,22 @@ Thread::Thread(const BamReference*    bam_reference,
 }
 
 void Thread::Init() {
+  ref_hasher_.SetHashSize(hash_setting_.hash_size);
+  ref_hasher_.SetWindowSize(hash_setting_.minimizer_window);
+  ref_hasher_.SetMaxOccurrence(hash_setting_.max_occurrence);
   
   // load special references and their hash tables if necessary
   if (target_event_.special_insertion) {
     sp_hasher_.SetFastaName(special_fasta_.c_str());
+    sp_hasher_.SetHashSize(hash_setting_.special_hash_size);
+    sp_hasher_.SetWindowSize(hash_setting_.minimizer_window);
+    sp_hasher_.SetMaxOccurrence(hash_setting_.max_occurrence);
     sp_hasher_.SetRefIdStartNo(bam_reference_->count_no_special);
     if (!sp_hasher_.Load()) {
       fprintf(stderr,"ERROR: The program cannot load special references.\n");
       exit(1);
     }
+    ReportMaskedHashes(sp_hasher_.GetHashTable(), "special references");
     // load special references
     //reference_special_ = SR_ReferenceAlloc();
     /*
@@ -327,11 +367,29 @@ bool Thread::LoadReference() {
     fprintf(stderr, "ERROR: The reference, %s, is not found in reference file.\n", ref_name.c_str());
 	exit(1);
   } else {
-    reference_bases_.clear();
-    reference_bases_ = ref_reader_->getSequence(ref_name);
+    uint32_t slice_begin = 0;
+    if (chromosome_id == target_region_.region_id) {
+      // Only the -r region is processed, so fetch the region padded by
+      // the discovery window instead of the whole chromosome.
+      // The padding is never smaller than what the aligner may look at
+      // around an anchor: the fragment length plus local windows on both sides.
+      int padding = target_region_.discovery_window_size;
+      const int local_reach = target_region_.fragment_length 
+                            + 2 * target_region_.local_window_size;
+      if (padding < local_reach) padding = local_reach;
+      const int begin = target_region_.region_begin > padding 
+                      ? target_region_.region_begin - padding : 0;
+      const int end   = target_region_.region_end + padding;
+      ref_reader_->getSubSequence(ref_name, begin, end - begin, reference_bases_);
+      slice_begin = begin;
+    } else {
+      // fill the chromosome in place; the buffer is reused across chromosomes
+      ref_reader_->getSequence(ref_name, reference_bases_);
+    }
     ref_hasher_.Clear();
-    ref_hasher_.SetSequence(reference_bases_.c_str());
+    ref_hasher_.SetSequence(reference_bases_.c_str(), slice_begin);
     ref_hasher_.Load();
+    ReportMaskedHashes(ref_hasher_.GetHashTable(), ref_name.c_str());
     //SR_ReferenceJump(ref_reader_, reference_header_, ref_id);
     //SR_InHashTableJump(hash_reader_, reference_header_, ref_id);
     //SR_ReferenceRead(reference_, ref_reader_);
@@ -13,6 +13,7 @@ extern "C" {
 }
 
 #include "dataStructures/alignment.h"
+#include "dataStructures/hash_setting.h"
 #include "dataStructures/target_event.h"
 #include "dataStructures/target_region.h"
 #include "dataStructures/technology.h"
@@ -61,6 +62,7 @@ class Thread {
 	 const int&             bam_mq_threshold,
 	 const AlignmentFilter& alignment_filter,
 	 const TargetRegion&    target_region,
+	 const HashSetting&     hash_setting,
 	 const string           special_fasta,
 	 FastaReference*        ref_reader,
 	 SR_BamInStream* bam_reader,
@@ -78,6 +80,7 @@ class Thread {
   const int             bam_mq_threshold_;
   const AlignmentFilter alignment_filter_;
   const TargetRegion    target_region_;
+  const HashSetting     hash_setting_;
   const string    special_fasta_;
   FastaReference* ref_reader_;
   SR_BamInStream* bam_reader_;
@@ -0,0 +1,67 @@
+#include "ungapped_extension.h"
+
+#include <sstream>
+
+namespace Scissors {
+namespace UngappedExtension {
+int Extend(const int8_t* read, const int8_t* ref, const int& low, const int& high,
+           const int& seed_begin, const int& match, const int& mismatch,
+           const int& xdrop, int* query_begin, int* query_end) {
+  int score = 0, right_score = 0;
+  *query_end = seed_begin - 1;
+  for (int j = seed_begin; j <= high; ++j) {
+    if (read[j] != 4 && ref[j] != 4) score += (read[j] == ref[j]) ? match : -mismatch;
+    if (score > right_score) {
+      right_score = score;
+      *query_end = j;
+    } else if (score < right_score - xdrop) {
+      break;
+    }
+  }
+
+  score = 0;
+  int left_score = 0;
+  *query_begin = seed_begin;
+  for (int j = seed_begin - 1; j >= low; --j) {
+    if (read[j] != 4 && ref[j] != 4) score += (read[j] == ref[j]) ? match : -mismatch;
+    if (score > left_score) {
+      left_score = score;
+      *query_begin = j;
+    } else if (score < left_score - xdrop) {
+      break;
+    }
+  }
+
+  return right_score + left_score;
+}
+
+void SetAlignment(const int8_t* read, const int8_t* ref, const int& read_length,
+                  const int& score, const int& query_begin, const int& query_end,
+                  const int& ref_begin, StripedSmithWaterman::Alignment* al) {
+  const int aligned_length = query_end - query_begin + 1;
+  al->Clear();
+  al->sw_score          = score;
+  al->ref_begin         = ref_begin + query_begin;
+  al->ref_end           = ref_begin + query_end;
+  al->query_begin       = query_begin;
+  al->query_end         = query_end;
+  al->ref_end_next_best = -1;
+  for (int j = query_begin; j <= query_end; ++j)
+    if (read[j] != ref[j]) ++al->mismatches;
+
+  std::ostringstream cigar_string;
+  if (query_begin > 0) {
+    al->cigar.push_back((query_begin << 4) | 0x04);
+    cigar_string << query_begin << 'S';
+  }
+  al->cigar.push_back(aligned_length << 4);
+  cigar_string << aligned_length << 'M';
+  const int end_clip = read_length - query_end - 1;
+  if (end_clip > 0) {
+    al->cigar.push_back((end_clip << 4) | 0x04);
+    cigar_string << end_clip << 'S';
+  }
+  al->cigar_string = cigar_string.str();
+}
+} // namespace UngappedExtension
+} // namespace Scissors
@@ -0,0 +1,35 @@
+#ifndef UTILITIES_MISCELLANEOUS_UNGAPPED_EXTENSION_H_
+#define UTILITIES_MISCELLANEOUS_UNGAPPED_EXTENSION_H_
+
+#include <stdint.h>
+
+#include "utilities/smithwaterman/ssw_cpp.h"
+
+namespace Scissors {
+// Ungapped X-drop extension of seeds, as --ungapped-xdrop uses it before
+//  the local SSW. The sequences are translated as SSW translates them;
+//  N (4) scores nothing against any base.
+namespace UngappedExtension {
+// @function: Extends a seed along its diagonal without gaps, rightwards
+//            from seed_begin and leftwards from seed_begin - 1, each as far
+//            as the score does not drop more than xdrop below the best one.
+// @param  ref         The reference on the diagonal: ref[j] faces read[j].
+// @param  low         The first read position that has a reference base.
+// @param  high        The last read position that has a reference base.
+// @param  query_begin The first read base of the best extension.
+// @param  query_end   The last read base of the best extension.
+// @return The score of the best extension; 0 if nothing scores.
+int Extend(const int8_t* read, const int8_t* ref, const int& low, const int& high,
+           const int& seed_begin, const int& match, const int& mismatch,
+           const int& xdrop, int* query_begin, int* query_end);
+
+// @function: Sets al to the extension [query_begin, query_end] of Extend
+//            as SSW reports an alignment: the cigar is [S]M[S].
+// @param  ref_begin The position of ref[0], to which al positions are relative.
+void SetAlignment(const int8_t* read, const int8_t* ref, const int& read_length,
+                  const int& score, const int& query_begin, const int& query_end,
+                  const int& ref_begin, StripedSmithWaterman::Alignment* al);
+} // namespace UngappedExtension
+} // namespace Scissors
+
+#endif // UTILITIES_MISCELLANEOUS_UNGAPPED_EXTENSION_H_
@@ -9,6 +9,7 @@
  */
 
 #include <emmintrin.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -49,15 +50,37 @@ typedef struct {
 } cigar;
 
 struct _profile{
-	__m128i* profile_byte;	// 0: none
-	__m128i* profile_word;	// 0: none
+	void* profile_byte;	// 0: none; striped for the kernels of simd
+	void* profile_word;	// 0: none; striped for the kernels of simd
 	const int8_t* read;
 	const int8_t* mat;
 	int32_t readLen;
 	int32_t n;
 	uint8_t bias;
+	ssw_simd simd;
 };
 
+/* Allocate zeroed memory aligned for the widest vector. */
+static void* ssw_calloc_aligned (size_t size) {
+	void* p = 0;
+	if (posix_memalign(&p, 64, size > 0 ? size : 64) != 0) return 0;
+	memset(p, 0, size);
+	return p;
+}
+
+/* Build the masks that keep the cells past the end of the read out of the column maxima.
+   Those cells copy the scores of earlier columns and their number depends on the width
+   of the registers. */
+static void* column_mask (int32_t readLen, int32_t segLen, int32_t lanes, int32_t laneBytes) {
+	uint8_t* mask = (uint8_t*)ssw_calloc_aligned(segLen * lanes * laneBytes);
+	int32_t j, segNum;
+	for (j = 0; j < segLen; ++j)
+		for (segNum = 0; segNum < lanes; ++segNum)
+			if (j + segNum * segLen < readLen)
+				memset(mask + (j * lanes + segNum) * laneBytes, 0xff, laneBytes);
+	return mask;
+}
+
 /* Generate query profile rearrange query sequence & calculate the weight of match/mismatch. */
 __m128i* qP_byte (const int8_t* read_num,
 				  const int8_t* mat,
@@ -131,6 +154,7 @@ alignment_end* sw_sse2_byte (const int8_t* ref,
 	__m128i* pvHLoad = (__m128i*) calloc(segLen, sizeof(__m128i));
 	__m128i* pvE = (__m128i*) calloc(segLen, sizeof(__m128i));
 	__m128i* pvHmax = (__m128i*) calloc(segLen, sizeof(__m128i));
+	__m128i* pvMask = (__m128i*) column_mask(readLen, segLen, 16, 1);
 
 	int32_t i, j;
 	/* 16 byte insertion begin vector */
@@ -187,7 +211,7 @@ alignment_end* sw_sse2_byte (const int8_t* ref,
 			e = _mm_load_si128(pvE + j);
 			vH = _mm_max_epu8(vH, e);
 			vH = _mm_max_epu8(vH, vF);
-			vMaxColumn = _mm_max_epu8(vMaxColumn, vH);
+			vMaxColumn = _mm_max_epu8(vMaxColumn, _mm_and_si128(vH, _mm_load_si128(pvMask + j)));
 			
 	//	max16(maxColumn[i], vMaxColumn);
 	//	fprintf(stderr, "middle[%d]: %d\n", i, maxColumn[i]);
@@ -227,7 +251,7 @@ alignment_end* sw_sse2_byte (const int8_t* ref,
         while (cmp != 0xffff) 
         {
             vH = _mm_max_epu8 (vH, vF);
-			vMaxColumn = _mm_max_epu8(vMaxColumn, vH);
+			vMaxColumn = _mm_max_epu8(vMaxColumn, _mm_and_si128(vH, _mm_load_si128(pvMask + j)));
             _mm_store_si128 (pvHStore + j, vH);
             vF = _mm_subs_epu8 (vF, vGapE);
             j++;
@@ -280,6 +304,7 @@ alignment_end* sw_sse2_byte (const int8_t* ref,
 		}
 	}
 
+	free(pvMask);
 	free(pvHmax);
 	free(pvE);
 	free(pvHLoad);
@@ -374,6 +399,7 @@ alignment_end* sw_sse2_word (const int8_t* ref,
 	__m128i* pvHLoad = (__m128i*) calloc(segLen, sizeof(__m128i));
 	__m128i* pvE = (__m128i*) calloc(segLen, sizeof(__m128i));
 	__m128i* pvHmax = (__m128i*) calloc(segLen, sizeof(__m128i));
+	__m128i* pvMask = (__m128i*) column_mask(readLen, segLen, 8, 2);
 
 	int32_t i, j, k;
 	/* 16 byte insertion begin vector */
@@ -419,7 +445,7 @@ alignment_end* sw_sse2_word (const int8_t* ref,
 			e = _mm_load_si128(pvE + j);
 			vH = _mm_max_epi16(vH, e);
 			vH = _mm_max_epi16(vH, vF);
-			vMaxColumn = _mm_max_epi16(vMaxColumn, vH);
+			vMaxColumn = _mm_max_epi16(vMaxColumn, _mm_and_si128(vH, _mm_load_si128(pvMask + j)));
 			
 			/* Save vH values. */
 			_mm_store_si128(pvHStore + j, vH);
@@ -484,6 +510,7 @@ end:
 		}
 	}
 
+	free(pvMask);
 	free(pvHmax);
 	free(pvE);
 	free(pvHLoad);
@@ -519,6 +546,257 @@ end:
 	return bests;
 }
 
+/* Kernels for wider registers, picked at run time by the instruction sets of the CPU. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (__GNUC__ >= 5 || defined(__clang__))
+#define SSW_WIDE_KERNELS
+#include <immintrin.h>
+#endif
+
+static ssw_simd ssw_simd_selected = SSW_SIMD_SSE2;	/* the widest kernels used by ssw_init */
+static int ssw_simd_by_length = 1;	/* 1: ssw_init narrows the kernels to the read length; 0: set by ssw_set_simd */
+static pthread_once_t ssw_simd_once = PTHREAD_ONCE_INIT;	/* sets the default of ssw_simd_selected */
+
+/* Same as qP_byte, but the read is split into lanes segments. */
+static void* qP_byte_striped (const int8_t* read_num,
+				  const int8_t* mat,
+				  const int32_t readLen,
+				  const int32_t n,
+				  uint8_t bias,
+				  int32_t lanes) {
+
+	int32_t segLen = (readLen + lanes - 1) / lanes;
+	int8_t* vProfile = (int8_t*)ssw_calloc_aligned(n * segLen * lanes);
+	int8_t* t = vProfile;
+	int32_t nt, i, j, segNum;
+
+	for (nt = 0; LIKELY(nt < n); nt ++) {
+		for (i = 0; i < segLen; i ++) {
+			j = i;
+			for (segNum = 0; LIKELY(segNum < lanes) ; segNum ++) {
+				*t++ = j>= readLen ? bias : mat[nt * n + read_num[j]] + bias;
+				j += segLen;
+			}
+		}
+	}
+	return vProfile;
+}
+
+/* Same as qP_word, but the read is split into lanes segments. */
+static void* qP_word_striped (const int8_t* read_num,
+				  const int8_t* mat,
+				  const int32_t readLen,
+				  const int32_t n,
+				  int32_t lanes) {
+
+	int32_t segLen = (readLen + lanes - 1) / lanes;
+	int16_t* vProfile = (int16_t*)ssw_calloc_aligned(n * segLen * lanes * sizeof(int16_t));
+	int16_t* t = vProfile;
+	int32_t nt, i, j, segNum;
+
+	for (nt = 0; LIKELY(nt < n); nt ++) {
+		for (i = 0; i < segLen; i ++) {
+			j = i;
+			for (segNum = 0; LIKELY(segNum < lanes) ; segNum ++) {
+				*t++ = j>= readLen ? 0 : mat[nt * n + read_num[j]];
+				j += segLen;
+			}
+		}
+	}
+	return vProfile;
+}
+
+#ifdef SSW_WIDE_KERNELS
+/* AVX2: 32 lanes of 8-bit and 16 lanes of 16-bit. */
+#define SSW_VEC					__m256i
+#define SSW_TARGET				__attribute__((target("avx2")))
+#define SSW_SW_BYTE				sw_avx2_byte
+#define SSW_SW_WORD				sw_avx2_word
+#define SSW_LANES_BYTE			32
+#define SSW_LANES_WORD			16
+#define SSW_ZERO()				_mm256_setzero_si256()
+#define SSW_SET1_EPI8(x)		_mm256_set1_epi8(x)
+#define SSW_SET1_EPI16(x)		_mm256_set1_epi16(x)
+#define SSW_LOAD(p)				_mm256_load_si256(p)
+#define SSW_STORE(p, v)			_mm256_store_si256((p), (v))
+#define SSW_AND(a, b)			_mm256_and_si256((a), (b))
+#define SSW_XOR(a, b)			_mm256_xor_si256((a), (b))
+#define SSW_ADDS_EPU8(a, b)		_mm256_adds_epu8((a), (b))
+#define SSW_SUBS_EPU8(a, b)		_mm256_subs_epu8((a), (b))
+#define SSW_MAX_EPU8(a, b)		_mm256_max_epu8((a), (b))
+#define SSW_ADDS_EPI16(a, b)	_mm256_adds_epi16((a), (b))
+#define SSW_SUBS_EPU16(a, b)	_mm256_subs_epu16((a), (b))
+#define SSW_MAX_EPI16(a, b)		_mm256_max_epi16((a), (b))
+/* The lower half is shifted in from zero and the upper half from the lower one. */
+#define SSW_SHIFT_LEFT(v, n)	_mm256_alignr_epi8((v), _mm256_permute2x128_si256((v), (v), 0x08), 16 - (n))
+#define SSW_IS_ZERO(v)			_mm256_testz_si256((v), (v))
+#define SSW_ANY_GT_EPI16(a, b)	_mm256_movemask_epi8(_mm256_cmpgt_epi16((a), (b)))
+#define SSW_REDUCE_EPU8(v)		_mm_max_epu8(_mm256_castsi256_si128(v), _mm256_extracti128_si256((v), 1))
+#define SSW_REDUCE_EPI16(v)		_mm_max_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256((v), 1))
+#include "ssw_kernel.h"
+#undef SSW_VEC
+#undef SSW_TARGET
+#undef SSW_SW_BYTE
+#undef SSW_SW_WORD
+#undef SSW_LANES_BYTE
+#undef SSW_LANES_WORD
+#undef SSW_ZERO
+#undef SSW_SET1_EPI8
+#undef SSW_SET1_EPI16
+#undef SSW_LOAD
+#undef SSW_STORE
+#undef SSW_AND
+#undef SSW_XOR
+#undef SSW_ADDS_EPU8
+#undef SSW_SUBS_EPU8
+#undef SSW_MAX_EPU8
+#undef SSW_ADDS_EPI16
+#undef SSW_SUBS_EPU16
+#undef SSW_MAX_EPI16
+#undef SSW_SHIFT_LEFT
+#undef SSW_IS_ZERO
+#undef SSW_ANY_GT_EPI16
+#undef SSW_REDUCE_EPU8
+#undef SSW_REDUCE_EPI16
+
+/* AVX-512BW: 64 lanes of 8-bit and 32 lanes of 16-bit. */
+#define SSW_VEC					__m512i
+#define SSW_TARGET				__attribute__((target("avx512bw")))
+#define SSW_SW_BYTE				sw_avx512_byte
+#define SSW_SW_WORD				sw_avx512_word
+#define SSW_LANES_BYTE			64
+#define SSW_LANES_WORD			32
+#define SSW_ZERO()				_mm512_setzero_si512()
+#define SSW_SET1_EPI8(x)		_mm512_set1_epi8(x)
+#define SSW_SET1_EPI16(x)		_mm512_set1_epi16(x)
+#define SSW_LOAD(p)				_mm512_load_si512(p)
+#define SSW_STORE(p, v)			_mm512_store_si512((p), (v))
+#define SSW_AND(a, b)			_mm512_and_si512((a), (b))
+#define SSW_XOR(a, b)			_mm512_xor_si512((a), (b))
+#define SSW_ADDS_EPU8(a, b)		_mm512_adds_epu8((a), (b))
+#define SSW_SUBS_EPU8(a, b)		_mm512_subs_epu8((a), (b))
+#define SSW_MAX_EPU8(a, b)		_mm512_max_epu8((a), (b))
+#define SSW_ADDS_EPI16(a, b)	_mm512_adds_epi16((a), (b))
+#define SSW_SUBS_EPU16(a, b)	_mm512_subs_epu16((a), (b))
+#define SSW_MAX_EPI16(a, b)		_mm512_max_epi16((a), (b))
+/* Each 128-bit lane is shifted in from the lane below it; the lowest one from zero. */
+#define SSW_SHIFT_LEFT(v, n)	_mm512_alignr_epi8((v), _mm512_maskz_shuffle_i64x2(0xfc, (v), (v), _MM_SHUFFLE(2, 1, 0, 0)), 16 - (n))
+#define SSW_IS_ZERO(v)			(_mm512_test_epi8_mask((v), (v)) == 0)
+#define SSW_ANY_GT_EPI16(a, b)	_mm512_cmpgt_epi16_mask((a), (b))
+#define SSW_REDUCE_EPU8(v)		_mm_max_epu8(_mm256_castsi256_si128(_mm256_max_epu8(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64((v), 1))), \
+									_mm256_extracti128_si256(_mm256_max_epu8(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64((v), 1)), 1))
+#define SSW_REDUCE_EPI16(v)		_mm_max_epi16(_mm256_castsi256_si128(_mm256_max_epi16(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64((v), 1))), \
+									_mm256_extracti128_si256(_mm256_max_epi16(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64((v), 1)), 1))
+#include "ssw_kernel.h"
+#undef SSW_VEC
+#undef SSW_TARGET
+#undef SSW_SW_BYTE
+#undef SSW_SW_WORD
+#undef SSW_LANES_BYTE
+#undef SSW_LANES_WORD
+#undef SSW_ZERO
+#undef SSW_SET1_EPI8
+#undef SSW_SET1_EPI16
+#undef SSW_LOAD
+#undef SSW_STORE
+#undef SSW_AND
+#undef SSW_XOR
+#undef SSW_ADDS_EPU8
+#undef SSW_SUBS_EPU8
+#undef SSW_MAX_EPU8
+#undef SSW_ADDS_EPI16
+#undef SSW_SUBS_EPU16
+#undef SSW_MAX_EPI16
+#undef SSW_SHIFT_LEFT
+#undef SSW_IS_ZERO
+#undef SSW_ANY_GT_EPI16
+#undef SSW_REDUCE_EPU8
+#undef SSW_REDUCE_EPI16
+#endif	// SSW_WIDE_KERNELS
+
+ssw_simd ssw_simd_supported (void) {
+#ifdef SSW_WIDE_KERNELS
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512bw")) return SSW_SIMD_AVX512;
+	if (__builtin_cpu_supports("avx2")) return SSW_SIMD_AVX2;
+#endif
+	return SSW_SIMD_SSE2;
+}
+
+/* The widest supported kernels are decided once, by the first of ssw_init and ssw_set_simd that
+   runs, so that threads creating profiles never write the choice. */
+static void ssw_simd_init (void) {
+	ssw_simd_selected = ssw_simd_supported();
+}
+
+ssw_simd ssw_set_simd (ssw_simd simd) {
+	pthread_once(&ssw_simd_once, ssw_simd_init);
+	ssw_simd supported = ssw_simd_supported();
+	ssw_simd_selected = simd < supported ? simd : supported;
+	ssw_simd_by_length = 0;
+	return ssw_simd_selected;
+}
+
+/* The kernels for a read of readLen. AVX2 only pays when each of its 8-bit lanes gets 8 or more
+   positions of the read; on shorter reads the wider kernels loop more often over the lazy-F
+   corrections and are slower than SSE2. AVX-512BW barely gains on AVX2 below 16 positions a lane. */
+static ssw_simd simd_for_length (int32_t readLen) {
+	ssw_simd simd = ssw_simd_selected;
+	if (!ssw_simd_by_length) return simd;
+	if (simd == SSW_SIMD_AVX512 && readLen < 64 * 16) simd = SSW_SIMD_AVX2;
+	if (simd == SSW_SIMD_AVX2 && readLen < 32 * 8) simd = SSW_SIMD_SSE2;
+	return simd;
+}
+
+/* Build the 8-bit query profile for the kernels of simd. */
+static void* profile_byte (ssw_simd simd, const int8_t* read_num, const int8_t* mat, const int32_t readLen, const int32_t n, uint8_t bias) {
+	switch (simd) {
+		case SSW_SIMD_AVX512: return qP_byte_striped(read_num, mat, readLen, n, bias, 64);
+		case SSW_SIMD_AVX2: return qP_byte_striped(read_num, mat, readLen, n, bias, 32);
+		default: return qP_byte(read_num, mat, readLen, n, bias);
+	}
+}
+
+/* Build the 16-bit query profile for the kernels of simd. */
+static void* profile_word (ssw_simd simd, const int8_t* read_num, const int8_t* mat, const int32_t readLen, const int32_t n) {
+	switch (simd) {
+		case SSW_SIMD_AVX512: return qP_word_striped(read_num, mat, readLen, n, 32);
+		case SSW_SIMD_AVX2: return qP_word_striped(read_num, mat, readLen, n, 16);
+		default: return qP_word(read_num, mat, readLen, n);
+	}
+}
+
+/* Run the 8-bit kernel of simd on a profile built by profile_byte. */
+static alignment_end* sw_byte (ssw_simd simd, const int8_t* ref, int8_t ref_dir, int32_t refLen, int32_t readLen,
+							   const uint8_t weight_gapO, const uint8_t weight_gapE, void* vProfile,
+							   uint8_t terminate, uint8_t bias, int32_t maskLen) {
+	switch (simd) {
+#ifdef SSW_WIDE_KERNELS
+		case SSW_SIMD_AVX512:
+			return sw_avx512_byte(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (const __m512i*)vProfile, terminate, bias, maskLen);
+		case SSW_SIMD_AVX2:
+			return sw_avx2_byte(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (const __m256i*)vProfile, terminate, bias, maskLen);
+#endif
+		default:
+			return sw_sse2_byte(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (__m128i*)vProfile, terminate, bias, maskLen);
+	}
+}
+
+/* Run the 16-bit kernel of simd on a profile built by profile_word. */
+static alignment_end* sw_word (ssw_simd simd, const int8_t* ref, int8_t ref_dir, int32_t refLen, int32_t readLen,
+							   const uint8_t weight_gapO, const uint8_t weight_gapE, void* vProfile,
+							   uint16_t terminate, int32_t maskLen) {
+	switch (simd) {
+#ifdef SSW_WIDE_KERNELS
+		case SSW_SIMD_AVX512:
+			return sw_avx512_word(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (const __m512i*)vProfile, terminate, maskLen);
+		case SSW_SIMD_AVX2:
+			return sw_avx2_word(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (const __m256i*)vProfile, terminate, maskLen);
+#endif
+		default:
+			return sw_sse2_word(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (__m128i*)vProfile, terminate, maskLen);
+	}
+}
+
 cigar* banded_sw (const int8_t* ref,
 				 const int8_t* read, 
 				 int32_t refLen, 
@@ -717,6 +995,8 @@ s_profile* ssw_init (const int8_t* read, const int32_t readLen, const int8_t* ma
 	p->profile_byte = 0;
 	p->profile_word = 0;
 	p->bias = 0;
+	pthread_once(&ssw_simd_once, ssw_simd_init);
+	p->simd = simd_for_length(readLen);
 	
 	if (score_size == 0 || score_size == 2) {
 		/* Find the bias to use in the substitution matrix */
@@ -725,9 +1005,9 @@ s_profile* ssw_init (const int8_t* read, const int32_t readLen, const int8_t* ma
 		bias = abs(bias);
 
 		p->bias = bias;
-		p->profile_byte = qP_byte (read, mat, readLen, n, bias);
+		p->profile_byte = profile_byte (p->simd, read, mat, readLen, n, bias);
 	}
-	if (score_size == 1 || score_size == 2) p->profile_word = qP_word (read, mat, readLen, n);
+	if (score_size == 1 || score_size == 2) p->profile_word = profile_word (p->simd, read, mat, readLen, n);
 	p->read = read;
 	p->mat = mat;
 	p->readLen = readLen;
@@ -746,13 +1026,13 @@ s_align* ssw_align (const s_profile* prof,
 				  	int32_t refLen, 
 				  	const uint8_t weight_gapO, 
 				  	const uint8_t weight_gapE, 
-					const uint8_t flag,	//  (from high to low) bit 5: return the best alignment beginning position; 6: if (ref_end1 - ref_begin1 <= filterd) && (read_end1 - read_begin1 <= filterd), return cigar; 7: if max score >= filters, return cigar; 8: always return cigar; if 6 & 7 are both setted, only return cigar when both filter fulfilled
+					const uint8_t flag,	//  (from high to low) bit 4: with bit 7, skip the beginning position as well when max score < filters; bit 5: return the best alignment beginning position; 6: if (ref_end1 - ref_begin1 <= filterd) && (read_end1 - read_begin1 <= filterd), return cigar; 7: if max score >= filters, return cigar; 8: always return cigar; if 6 & 7 are both setted, only return cigar when both filter fulfilled
 					const uint16_t filters,
 					const int32_t filterd,
 					const int32_t maskLen) {
 
 	alignment_end* bests = 0, *bests_reverse = 0;
-	__m128i* vP = 0;
+	void* vP = 0;
 	int32_t word = 0, band_width = 0, readLen = prof->readLen;
 	int8_t* read_reverse = 0;
 	cigar* path;
@@ -767,17 +1047,17 @@ s_align* ssw_align (const s_profile* prof,
 
 	// Find the alignment scores and ending positions
 	if (prof->profile_byte) {
-		bests = sw_sse2_byte(ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_byte, -1, prof->bias, maskLen);
+		bests = sw_byte(prof->simd, ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_byte, -1, prof->bias, maskLen);
 		if (prof->profile_word && bests[0].score == 255) {
 			free(bests);
-			bests = sw_sse2_word(ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_word, -1, maskLen);
+			bests = sw_word(prof->simd, ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_word, -1, maskLen);
 			word = 1;
 		} else if (bests[0].score == 255) {
 			fprintf(stderr, "Please set 2 to the score_size parameter of the function ssw_init, otherwise the alignment results will be incorrect.\n");
 			return 0;
 		}
 	}else if (prof->profile_word) {
-		bests = sw_sse2_word(ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_word, -1, maskLen);
+		bests = sw_word(prof->simd, ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_word, -1, maskLen);
 		word = 1;
 	}else {
 		fprintf(stderr, "Please call the function ssw_init before ssw_align.\n");
@@ -794,16 +1074,16 @@ s_align* ssw_align (const s_profile* prof,
 		r->ref_end2 = -1;
 	}
 	free(bests);
-	if (flag == 0 || (flag == 2 && r->score1 < filters)) goto end;
+	if (flag == 0 || ((flag == 2 || (flag & 0x12) == 0x12) && r->score1 < filters)) goto end;
 
 	// Find the beginning position of the best alignment.
 	read_reverse = seq_reverse(prof->read, r->read_end1);
 	if (word == 0) {
-		vP = qP_byte(read_reverse, prof->mat, r->read_end1 + 1, prof->n, prof->bias);
-		bests_reverse = sw_sse2_byte(ref, 1, r->ref_end1 + 1, r->read_end1 + 1, weight_gapO, weight_gapE, vP, r->score1, prof->bias, maskLen);
+		vP = profile_byte(prof->simd, read_reverse, prof->mat, r->read_end1 + 1, prof->n, prof->bias);
+		bests_reverse = sw_byte(prof->simd, ref, 1, r->ref_end1 + 1, r->read_end1 + 1, weight_gapO, weight_gapE, vP, r->score1, prof->bias, maskLen);
 	} else {
-		vP = qP_word(read_reverse, prof->mat, r->read_end1 + 1, prof->n);
-		bests_reverse = sw_sse2_word(ref, 1, r->ref_end1 + 1, r->read_end1 + 1, weight_gapO, weight_gapE, vP, r->score1, maskLen);
+		vP = profile_word(prof->simd, read_reverse, prof->mat, r->read_end1 + 1, prof->n);
+		bests_reverse = sw_word(prof->simd, ref, 1, r->ref_end1 + 1, r->read_end1 + 1, weight_gapO, weight_gapE, vP, r->score1, maskLen);
 	}
 	free(vP);
 	free(read_reverse);
@@ -20,6 +20,17 @@
 struct _profile;
 typedef struct _profile s_profile;
 
+/*!	@typedef	instruction sets of the striped Smith-Waterman kernels; the kernels of all the sets give the same results
+	@constant	SSW_SIMD_SSE2	16 lanes of 8-bit and 8 lanes of 16-bit
+	@constant	SSW_SIMD_AVX2	32 lanes of 8-bit and 16 lanes of 16-bit
+	@constant	SSW_SIMD_AVX512	64 lanes of 8-bit and 32 lanes of 16-bit; needs AVX-512BW
+*/
+typedef enum {
+	SSW_SIMD_SSE2 = 0,
+	SSW_SIMD_AVX2 = 1,
+	SSW_SIMD_AVX512 = 2
+} ssw_simd;
+
 /*!	@typedef	structure of the alignment result
 	@field	score1	the best alignment score
 	@field	score2	sub-optimal alignment score
@@ -70,6 +81,21 @@ extern "C" {
 */
 s_profile* ssw_init (const int8_t* read, const int32_t readLen, const int8_t* mat, const int32_t n, const int8_t score_size);
 
+/*!	@function	Find the widest kernels that both the build and the CPU support.
+	@return	the instruction set of the kernels
+*/
+ssw_simd ssw_simd_supported (void);
+
+/*!	@function	Choose the kernels used by the query profiles that ssw_init creates afterwards. By default ssw_init
+				picks the kernels by the read length, where the wider ones are faster: SSE2 below 256 bp, AVX2
+				below 1024 bp and the widest supported ones above; once this is called, every profile uses simd. A profile keeps the
+				kernels it was created with. ssw_init only reads the choice, so call this before starting threads
+				that create profiles.
+	@param	simd	the wanted instruction set; it is lowered to ssw_simd_supported() when the CPU lacks it
+	@return	the instruction set actually chosen
+*/
+ssw_simd ssw_set_simd (ssw_simd simd);
+
 /*!	@function	Release the memory allocated by function ssw_init.
 	@param	p	pointer to the query profile structure	
 */
@@ -88,7 +114,9 @@ void init_destroy (s_profile* p);
 					< filterd), (whatever bit 5 is setted) the function will return the best alignment beginning position and 
 					cigar; bit 7: when setted as 1, if the best alignment score >= filters, (whatever bit 5 is setted) the function
   					will return the best alignment beginning position and cigar; bit 8: when setted as 1, (whatever bit 5, 6 or 7 is
- 					setted) the function will always return the best alignment beginning position and cigar
+ 					setted) the function will always return the best alignment beginning position and cigar; bit 4: when setted as 1
+					together with bit 7, the function won't search the beginning position either if the best alignment score < 
+					filters, so an alignment that fails the score filter costs only the search of its ending position
 	@param	filters	score filter: when bit 7 of flag is setted as 1 and bit 8 is setted as 0, filters will be used (Please check the
  					decription of the flag parameter for detailed usage.)
 	@param	filterd	distance filter: when bit 6 of flag is setted as 1 and bit 8 is setted as 0, filterd will be used (Please check 
@@ -127,6 +127,7 @@ int CalculateNumberMismatch(
 void SetFlag(const StripedSmithWaterman::Filter& filter, uint8_t* flag) {
   if (filter.report_begin_position) *flag |= 0x08;
   if (filter.report_cigar) *flag |= 0x0f;
+  if (filter.filter_begin_position) *flag |= 0x10;
 }
 
 } // namespace
@@ -147,6 +148,7 @@ Aligner::Aligner(void)
     , gap_extending_penalty_(1)
     , translated_reference_(NULL)
     , reference_length_(0)
+    , next_query_profile_(0)
 {
   BuildDefaultMatrix();
 }
@@ -168,6 +170,7 @@ Aligner::Aligner(
     , gap_extending_penalty_(gap_extending_penalty)
     , translated_reference_(NULL)
     , reference_length_(0)
+    , next_query_profile_(0)
 {
   BuildDefaultMatrix();
 }
@@ -188,6 +191,7 @@ Aligner::Aligner(const int8_t* score_matrix,
     , gap_extending_penalty_(1)
     , translated_reference_(NULL)
     , reference_length_(0)
+    , next_query_profile_(0)
 {
   score_matrix_ = new int8_t[score_matrix_size_ * score_matrix_size_];
   memcpy(score_matrix_, score_matrix, sizeof(int8_t) * score_matrix_size_ * score_matrix_size_);
@@ -249,30 +253,23 @@ bool Aligner::Align(const char* query, const Filter& filter,
 
   int query_len = strlen(query);
   if (query_len == 0) return false;
-  int8_t* translated_query = new int8_t[query_len];
-  TranslateBase(query, query_len, translated_query);
-
-  const int8_t score_size = 2;
-  s_profile* profile = ssw_init(translated_query, query_len, score_matrix_, 
-                                score_matrix_size_, score_size);
+  const QueryProfile& query_profile = GetQueryProfile(query, query_len);
 
   uint8_t flag = 0;
   SetFlag(filter, &flag);
-  s_align* s_al = ssw_align(profile, translated_reference_, reference_length_,
+  s_align* s_al = ssw_align(query_profile.profile, translated_reference_, reference_length_,
                                  static_cast<int>(gap_opening_penalty_), 
 				 static_cast<int>(gap_extending_penalty_),
 				 flag, filter.score_filter, filter.distance_filter, query_len);
   
   alignment->Clear();
   ConvertAlignment(*s_al, query_len, alignment);
-  alignment->mismatches = CalculateNumberMismatch(*alignment, translated_reference_, translated_query);
+  alignment->mismatches = CalculateNumberMismatch(*alignment, translated_reference_, 
+                                                  query_profile.translated_query);
 
 
   // Free memory
-  if (query_len > 1) delete [] translated_query;
-  else delete translated_query;
   align_destroy(s_al);
-  init_destroy(profile);
 
   return true;
 }
@@ -283,47 +280,89 @@ bool Aligner::Align(const char* query, const char* ref, const int& ref_len,
 {
   if (!matrix_built_) return false;
   
-  int query_len = strlen(query);
-  if (query_len == 0) return false;
-  int8_t* translated_query = new int8_t[query_len];
-  TranslateBase(query, query_len, translated_query);
-
   // calculate the valid length
   //int calculated_ref_length = static_cast<int>(strlen(ref));
   //int valid_ref_len = (calculated_ref_length > ref_len) 
   //                    ? ref_len : calculated_ref_length;
   int valid_ref_len = ref_len;
-  int8_t* translated_ref = new int8_t[valid_ref_len];
-  TranslateBase(ref, valid_ref_len, translated_ref);
+  if (static_cast<int>(translated_ref_buffer_.size()) < valid_ref_len + 1)
+    translated_ref_buffer_.resize(valid_ref_len + 1);
+  TranslateBase(ref, valid_ref_len, &translated_ref_buffer_[0]);
 
+  return Align(query, &translated_ref_buffer_[0], valid_ref_len, filter, alignment);
+}
 
-  const int8_t score_size = 2;
-  s_profile* profile = ssw_init(translated_query, query_len, score_matrix_, 
-                                score_matrix_size_, score_size);
+bool Aligner::Align(const char* query, const int8_t* translated_ref, const int& ref_len,
+                    const Filter& filter, Alignment* alignment) const
+{
+  if (!matrix_built_) return false;
+  
+  int query_len = strlen(query);
+  if (query_len == 0) return false;
+  const QueryProfile& query_profile = GetQueryProfile(query, query_len);
+  const int valid_ref_len = ref_len;
 
   uint8_t flag = 0;
   SetFlag(filter, &flag);
-  s_align* s_al = ssw_align(profile, translated_ref, valid_ref_len,
+  s_align* s_al = ssw_align(query_profile.profile, translated_ref, valid_ref_len,
                                  static_cast<int>(gap_opening_penalty_), 
 				 static_cast<int>(gap_extending_penalty_),
 				 flag, filter.score_filter, filter.distance_filter, query_len);
   
   alignment->Clear();
   ConvertAlignment(*s_al, query_len, alignment);
-  alignment->mismatches = CalculateNumberMismatch(*alignment, translated_ref, translated_query);
+  alignment->mismatches = CalculateNumberMismatch(*alignment, translated_ref, 
+                                                  query_profile.translated_query);
 
   // Free memory
-  if (query_len > 1) delete [] translated_query;
-  else delete translated_query;
-  if (valid_ref_len > 1) delete [] translated_ref;
-  else delete translated_ref;
   align_destroy(s_al);
-  init_destroy(profile);
 
   return true;
 }
 
+const Aligner::QueryProfile& Aligner::GetQueryProfile(const char* query, 
+    const int& query_len) const {
+  for (int i = 0; i < kQueryProfileCount; ++i) {
+    const QueryProfile& query_profile = query_profiles_[i];
+    if (query_profile.profile != NULL
+        && static_cast<int>(query_profile.query.size()) == query_len
+        && memcmp(query_profile.query.data(), query, query_len) == 0)
+      return query_profile;
+  }
+
+  QueryProfile& query_profile = query_profiles_[next_query_profile_];
+  next_query_profile_ = (next_query_profile_ + 1) % kQueryProfileCount;
+
+  if (query_profile.profile != NULL) init_destroy(query_profile.profile);
+  delete [] query_profile.translated_query;
+
+  query_profile.query.assign(query, query_len);
+  query_profile.translated_query = new int8_t[query_len];
+  TranslateBase(query, query_len, query_profile.translated_query);
+
+  const int8_t score_size = 2;
+  query_profile.profile = ssw_init(query_profile.translated_query, query_len, 
+                                   score_matrix_, score_matrix_size_, score_size);
+
+  return query_profile;
+}
+
+void Aligner::ClearQueryProfiles(void) {
+  for (int i = 0; i < kQueryProfileCount; ++i) {
+    QueryProfile& query_profile = query_profiles_[i];
+    if (query_profile.profile != NULL) init_destroy(query_profile.profile);
+    delete [] query_profile.translated_query;
+    query_profile.query.clear();
+    query_profile.translated_query = NULL;
+    query_profile.profile = NULL;
+  }
+
+  next_query_profile_ = 0;
+}
+
 void Aligner::Clear(void) {
+  ClearQueryProfiles();
+
   if (score_matrix_) delete [] score_matrix_;
   score_matrix_ = NULL;
 
@@ -382,6 +421,8 @@ bool Aligner::ReBuild(
     const int8_t* translation_matrix,
     const int&    translation_matrix_size) {
 
+  // the profiles are built on the old matrix
+  ClearQueryProfiles();
   score_matrix_ = new int8_t[score_matrix_size_ * score_matrix_size_];
   memcpy(score_matrix_, score_matrix, sizeof(int8_t) * score_matrix_size_ * score_matrix_size_);
   translation_matrix_ = new int8_t[translation_matrix_size];
@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+struct _profile;
+
 namespace StripedSmithWaterman {
 
 struct Alignment {
@@ -57,11 +59,16 @@ struct Filter {
   uint16_t distance_filter;      // ((ref_end - ref_begin) < distance_filter) &&
                                  // ((query_end - read_begin) < distance_filter)
 
+  bool filter_begin_position;    // ref_begin and query_begin are not searched either
+                                 //   (they are -1) when the score fails score_filter;
+                                 //   the reverse pass of SSW is skipped for them.
+
   Filter()
     : report_begin_position(true)
     , report_cigar(true)
     , score_filter(0)
     , distance_filter(32767)
+    , filter_begin_position(false)
   {};
 };
 
@@ -120,6 +127,16 @@ class Aligner {
     gap_extending_penalty_ = extending;
   };
 
+  // =========
+  // @function Get the scores that the aligner is built on.
+  //           [NOTICE] They are meaningless for an aligner built
+  //                    on a specific matrix.
+  // =========
+  uint8_t GetMatchScore(void) const {return match_score_;};
+  uint8_t GetMismatchPenalty(void) const {return mismatch_penalty_;};
+  uint8_t GetGapOpeningPenalty(void) const {return gap_opening_penalty_;};
+  uint8_t GetGapExtendingPenalty(void) const {return gap_extending_penalty_;};
+
   // =========
   // @function Align the query againt the reference that is set by 
   //             SetReferenceSequence.
@@ -145,6 +162,30 @@ class Aligner {
   bool Align(const char* query, const char* ref, const int& ref_len, 
              const Filter& filter, Alignment* alignment) const;
 
+  // =========
+  // @function Align the query againt a reference that is already
+  //             translated by Translate, e.g. a cached window.
+  // @param    query          The query sequence.
+  // @param    translated_ref The translated reference.
+  // @param    ref_len        The length of the reference sequence.
+  // @param    filter         The filter for the alignment.
+  // @param    alignment      The container contains the result.
+  // @return   True: succeed; false: fail.
+  // =========
+  bool Align(const char* query, const int8_t* translated_ref, const int& ref_len, 
+             const Filter& filter, Alignment* alignment) const;
+
+  // =========
+  // @function Translate bases into the alphabet of the score matrix.
+  // @param    bases      The bases; not necessary null terminated.
+  // @param    length     The number of bases.
+  // @param    translated The output; at least length long.
+  // @return   The number of translated bases.
+  // =========
+  int Translate(const char* bases, const int& length, int8_t* translated) const {
+    return TranslateBase(bases, length, translated);
+  }
+
   // @function Clear up all containers and thus the aligner is disabled.
   //             To rebuild the aligner please use Build functions.
   void Clear(void);
@@ -193,7 +234,25 @@ class Aligner {
   int8_t* translated_reference_;
   int32_t reference_length_;
 
+  // The profiles of the recently aligned queries. A read is aligned
+  //  in the same orientation by several stages, so its profile is
+  //  built once and reused until it is replaced (round robin).
+  struct QueryProfile {
+    std::string       query;
+    int8_t*           translated_query;
+    struct _profile*  profile;
+    QueryProfile() : query(), translated_query(NULL), profile(NULL) {}
+  };
+  static const int kQueryProfileCount = 4;
+  mutable QueryProfile query_profiles_[kQueryProfileCount];
+  mutable int next_query_profile_;
+
+  // Buffer of references that are translated by Align
+  mutable std::vector<int8_t> translated_ref_buffer_;
+
   int TranslateBase(const char* bases, const int& length, int8_t* translated) const;
+  const QueryProfile& GetQueryProfile(const char* query, const int& query_len) const;
+  void ClearQueryProfiles(void);
   void SetAllDefault(void);
   void BuildDefaultMatrix(void);
   
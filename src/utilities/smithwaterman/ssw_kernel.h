@@ -0,0 +1,379 @@
+/*
+ *  ssw_kernel.h
+ *
+ *	Striped Smith-Waterman kernels for registers wider than 128 bits.
+ *	This file is included by ssw.c once per instruction set, after it has
+ *	defined the vector type and operations below; it is not a public header.
+ *
+ *	SSW_VEC					vector type
+ *	SSW_TARGET				function attribute that enables the instruction set
+ *	SSW_SW_BYTE, SSW_SW_WORD	names of the generated kernels
+ *	SSW_LANES_BYTE, SSW_LANES_WORD	number of 8-bit and 16-bit lanes
+ *	SSW_ZERO, SSW_SET1_EPI8, SSW_SET1_EPI16, SSW_LOAD, SSW_STORE, SSW_AND, SSW_XOR,
+ *	SSW_ADDS_EPU8, SSW_SUBS_EPU8, SSW_MAX_EPU8, SSW_ADDS_EPI16, SSW_SUBS_EPU16,
+ *	SSW_MAX_EPI16			the element-wise operations
+ *	SSW_SHIFT_LEFT(v, n)	shift the whole vector left by n bytes
+ *	SSW_IS_ZERO(v)			true when all the bits of v are 0
+ *	SSW_ANY_GT_EPI16(a, b)	true when any 16-bit lane of a is greater than b
+ *	SSW_REDUCE_EPU8, SSW_REDUCE_EPI16	fold the vector into a __m128i by max
+ *
+ *	The kernels follow sw_sse2_byte and sw_sse2_word step by step, so they
+ *	give the same scores and positions; only the striping of the read
+ *	differs.
+ */
+
+/* Return the max 8-bit lane of a 128-bit vector. */
+#ifndef ssw_hmax_epu8
+#define ssw_hmax_epu8(m, vm) (vm) = _mm_max_epu8((vm), _mm_srli_si128((vm), 8)); \
+					(vm) = _mm_max_epu8((vm), _mm_srli_si128((vm), 4)); \
+					(vm) = _mm_max_epu8((vm), _mm_srli_si128((vm), 2)); \
+					(vm) = _mm_max_epu8((vm), _mm_srli_si128((vm), 1)); \
+					(m) = _mm_extract_epi16((vm), 0)
+#endif
+
+/* Return the max 16-bit lane of a 128-bit vector. */
+#ifndef ssw_hmax_epi16
+#define ssw_hmax_epi16(m, vm) (vm) = _mm_max_epi16((vm), _mm_srli_si128((vm), 8)); \
+					(vm) = _mm_max_epi16((vm), _mm_srli_si128((vm), 4)); \
+					(vm) = _mm_max_epi16((vm), _mm_srli_si128((vm), 2)); \
+					(m) = _mm_extract_epi16((vm), 0)
+#endif
+
+SSW_TARGET
+static alignment_end* SSW_SW_BYTE (const int8_t* ref,
+							 int8_t ref_dir,	// 0: forward ref; 1: reverse ref
+							 int32_t refLen,
+							 int32_t readLen,
+							 const uint8_t weight_gapO, /* will be used as - */
+							 const uint8_t weight_gapE, /* will be used as - */
+							 const SSW_VEC* vProfile,
+							 uint8_t terminate,
+							 uint8_t bias,  /* Shift 0 point to a positive value. */
+							 int32_t maskLen) {
+
+	uint8_t max = 0;		                     /* the max alignment score */
+	int32_t end_read = readLen - 1;
+	int32_t end_ref = -1; /* 0_based best alignment ending point; Initialized as isn't aligned -1. */
+	int32_t segLen = (readLen + SSW_LANES_BYTE - 1) / SSW_LANES_BYTE; /* number of segment */
+
+	/* array to record the largest score of each reference position */
+	uint8_t* maxColumn = (uint8_t*) calloc(refLen, 1);
+
+	SSW_VEC vZero = SSW_ZERO();
+
+	SSW_VEC* pvHStore = (SSW_VEC*) ssw_calloc_aligned(segLen * sizeof(SSW_VEC));
+	SSW_VEC* pvHLoad = (SSW_VEC*) ssw_calloc_aligned(segLen * sizeof(SSW_VEC));
+	SSW_VEC* pvE = (SSW_VEC*) ssw_calloc_aligned(segLen * sizeof(SSW_VEC));
+	SSW_VEC* pvHmax = (SSW_VEC*) ssw_calloc_aligned(segLen * sizeof(SSW_VEC));
+	SSW_VEC* pvMask = (SSW_VEC*) column_mask(readLen, segLen, SSW_LANES_BYTE, 1);
+
+	int32_t i, j;
+	SSW_VEC vGapO = SSW_SET1_EPI8(weight_gapO);
+	SSW_VEC vGapE = SSW_SET1_EPI8(weight_gapE);
+	SSW_VEC vBias = SSW_SET1_EPI8(bias);
+
+	SSW_VEC vMaxScore = vZero; /* Trace the highest score of the whole SW matrix. */
+	SSW_VEC vMaxMark = vZero; /* Trace the highest score till the previous column. */
+	SSW_VEC vTemp;
+	__m128i vReduced;
+	int32_t edge, begin = 0, end = refLen, step = 1;
+
+	/* outer loop to process the reference sequence */
+	if (ref_dir == 1) {
+		begin = refLen - 1;
+		end = -1;
+		step = -1;
+	}
+	for (i = begin; LIKELY(i != end); i += step) {
+		SSW_VEC e, vF = vZero, vMaxColumn = vZero;
+		SSW_VEC vH = SSW_LOAD(pvHStore + segLen - 1);
+		vH = SSW_SHIFT_LEFT(vH, 1);
+		const SSW_VEC* vP = vProfile + ref[i] * segLen; /* Right part of the vProfile */
+
+		/* Swap the 2 H buffers. */
+		SSW_VEC* pv = pvHLoad;
+		pvHLoad = pvHStore;
+		pvHStore = pv;
+
+		/* inner loop to process the query sequence */
+		for (j = 0; LIKELY(j < segLen); ++j) {
+			vH = SSW_ADDS_EPU8(vH, SSW_LOAD(vP + j));
+			vH = SSW_SUBS_EPU8(vH, vBias); /* vH will be always > 0 */
+
+			/* Get max from vH, vE and vF. */
+			e = SSW_LOAD(pvE + j);
+			vH = SSW_MAX_EPU8(vH, e);
+			vH = SSW_MAX_EPU8(vH, vF);
+			vMaxColumn = SSW_MAX_EPU8(vMaxColumn, SSW_AND(vH, SSW_LOAD(pvMask + j)));
+
+			/* Save vH values. */
+			SSW_STORE(pvHStore + j, vH);
+
+			/* Update vE value. */
+			vH = SSW_SUBS_EPU8(vH, vGapO); /* saturation arithmetic, result >= 0 */
+			e = SSW_SUBS_EPU8(e, vGapE);
+			e = SSW_MAX_EPU8(e, vH);
+			SSW_STORE(pvE + j, e);
+
+			/* Update vF value. */
+			vF = SSW_SUBS_EPU8(vF, vGapE);
+			vF = SSW_MAX_EPU8(vF, vH);
+
+			/* Load the next vH. */
+			vH = SSW_LOAD(pvHLoad + j);
+		}
+
+		/* Lazy_F loop: disallow adjecent insertion and then deletion, so don't update E(i, j) */
+		j = 0;
+		vH = SSW_LOAD(pvHStore + j);
+		vF = SSW_SHIFT_LEFT(vF, 1);
+		vTemp = SSW_SUBS_EPU8(vH, vGapO);
+		vTemp = SSW_SUBS_EPU8(vF, vTemp);
+
+		while (!SSW_IS_ZERO(vTemp)) {
+			vH = SSW_MAX_EPU8(vH, vF);
+			vMaxColumn = SSW_MAX_EPU8(vMaxColumn, SSW_AND(vH, SSW_LOAD(pvMask + j)));
+			SSW_STORE(pvHStore + j, vH);
+			vF = SSW_SUBS_EPU8(vF, vGapE);
+			j++;
+			if (j >= segLen) {
+				j = 0;
+				vF = SSW_SHIFT_LEFT(vF, 1);
+			}
+			vH = SSW_LOAD(pvHStore + j);
+
+			vTemp = SSW_SUBS_EPU8(vH, vGapO);
+			vTemp = SSW_SUBS_EPU8(vF, vTemp);
+		}
+
+		vMaxScore = SSW_MAX_EPU8(vMaxScore, vMaxColumn);
+		if (!SSW_IS_ZERO(SSW_XOR(vMaxMark, vMaxScore))) {
+			uint8_t temp;
+			vMaxMark = vMaxScore;
+			vReduced = SSW_REDUCE_EPU8(vMaxScore);
+			ssw_hmax_epu8(temp, vReduced);
+
+			if (LIKELY(temp > max)) {
+				max = temp;
+				if (max + bias >= 255) break;	//overflow
+				end_ref = i;
+
+				/* Store the column with the highest alignment score in order to trace the alignment ending position on read. */
+				for (j = 0; LIKELY(j < segLen); ++j) pvHmax[j] = pvHStore[j];
+			}
+		}
+
+		/* Record the max score of current column. */
+		vReduced = SSW_REDUCE_EPU8(vMaxColumn);
+		ssw_hmax_epu8(maxColumn[i], vReduced);
+		if (maxColumn[i] == terminate) break;
+	}
+
+	/* Trace the alignment ending position on read. */
+	uint8_t *t = (uint8_t*)pvHmax;
+	int32_t column_len = segLen * SSW_LANES_BYTE;
+	for (i = 0; LIKELY(i < column_len); ++i, ++t) {
+		int32_t temp;
+		if (*t == max) {
+			temp = i / SSW_LANES_BYTE + i % SSW_LANES_BYTE * segLen;
+			if (temp < end_read) end_read = temp;
+		}
+	}
+
+	free(pvMask);
+	free(pvHmax);
+	free(pvE);
+	free(pvHLoad);
+	free(pvHStore);
+
+	/* Find the most possible 2nd best alignment. */
+	alignment_end* bests = (alignment_end*) calloc(2, sizeof(alignment_end));
+	bests[0].score = max + bias >= 255 ? 255 : max;
+	bests[0].ref = end_ref;
+	bests[0].read = end_read;
+
+	bests[1].score = 0;
+	bests[1].ref = 0;
+	bests[1].read = 0;
+
+	edge = (end_ref - maskLen) > 0 ? (end_ref - maskLen) : 0;
+	for (i = 0; i < edge; i ++) {
+		if (maxColumn[i] > bests[1].score) {
+			bests[1].score = maxColumn[i];
+			bests[1].ref = i;
+		}
+	}
+	edge = (end_ref + maskLen) > refLen ? refLen : (end_ref + maskLen);
+	for (i = edge + 1; i < refLen; i ++) {
+		if (maxColumn[i] > bests[1].score) {
+			bests[1].score = maxColumn[i];
+			bests[1].ref = i;
+		}
+	}
+
+	free(maxColumn);
+	return bests;
+}
+
+SSW_TARGET
+static alignment_end* SSW_SW_WORD (const int8_t* ref,
+							 int8_t ref_dir,	// 0: forward ref; 1: reverse ref
+							 int32_t refLen,
+							 int32_t readLen,
+							 const uint8_t weight_gapO, /* will be used as - */
+							 const uint8_t weight_gapE, /* will be used as - */
+							 const SSW_VEC* vProfile,
+							 uint16_t terminate,
+							 int32_t maskLen) {
+
+	uint16_t max = 0;		                     /* the max alignment score */
+	int32_t end_read = readLen - 1;
+	int32_t end_ref = 0; /* 1_based best alignment ending point; Initialized as isn't aligned - 0. */
+	int32_t segLen = (readLen + SSW_LANES_WORD - 1) / SSW_LANES_WORD; /* number of segment */
+
+	/* array to record the largest score of each reference position */
+	uint16_t* maxColumn = (uint16_t*) calloc(refLen, 2);
+
+	SSW_VEC vZero = SSW_ZERO();
+
+	SSW_VEC* pvHStore = (SSW_VEC*) ssw_calloc_aligned(segLen * sizeof(SSW_VEC));
+	SSW_VEC* pvHLoad = (SSW_VEC*) ssw_calloc_aligned(segLen * sizeof(SSW_VEC));
+	SSW_VEC* pvE = (SSW_VEC*) ssw_calloc_aligned(segLen * sizeof(SSW_VEC));
+	SSW_VEC* pvHmax = (SSW_VEC*) ssw_calloc_aligned(segLen * sizeof(SSW_VEC));
+	SSW_VEC* pvMask = (SSW_VEC*) column_mask(readLen, segLen, SSW_LANES_WORD, 2);
+
+	int32_t i, j, k;
+	SSW_VEC vGapO = SSW_SET1_EPI16(weight_gapO);
+	SSW_VEC vGapE = SSW_SET1_EPI16(weight_gapE);
+
+	SSW_VEC vMaxScore = vZero; /* Trace the highest score of the whole SW matrix. */
+	SSW_VEC vMaxMark = vZero; /* Trace the highest score till the previous column. */
+	__m128i vReduced;
+	int32_t edge, begin = 0, end = refLen, step = 1;
+
+	/* outer loop to process the reference sequence */
+	if (ref_dir == 1) {
+		begin = refLen - 1;
+		end = -1;
+		step = -1;
+	}
+	for (i = begin; LIKELY(i != end); i += step) {
+		SSW_VEC e, vF = vZero;
+		SSW_VEC vH = SSW_LOAD(pvHStore + segLen - 1);
+		vH = SSW_SHIFT_LEFT(vH, 2);
+
+		/* Swap the 2 H buffers. */
+		SSW_VEC* pv = pvHLoad;
+
+		SSW_VEC vMaxColumn = vZero; /* vMaxColumn is used to record the max values of column i. */
+
+		const SSW_VEC* vP = vProfile + ref[i] * segLen; /* Right part of the vProfile */
+		pvHLoad = pvHStore;
+		pvHStore = pv;
+
+		/* inner loop to process the query sequence */
+		for (j = 0; LIKELY(j < segLen); j ++) {
+			vH = SSW_ADDS_EPI16(vH, SSW_LOAD(vP + j));
+
+			/* Get max from vH, vE and vF. */
+			e = SSW_LOAD(pvE + j);
+			vH = SSW_MAX_EPI16(vH, e);
+			vH = SSW_MAX_EPI16(vH, vF);
+			vMaxColumn = SSW_MAX_EPI16(vMaxColumn, SSW_AND(vH, SSW_LOAD(pvMask + j)));
+
+			/* Save vH values. */
+			SSW_STORE(pvHStore + j, vH);
+
+			/* Update vE value. */
+			vH = SSW_SUBS_EPU16(vH, vGapO); /* saturation arithmetic, result >= 0 */
+			e = SSW_SUBS_EPU16(e, vGapE);
+			e = SSW_MAX_EPI16(e, vH);
+			SSW_STORE(pvE + j, e);
+
+			/* Update vF value. */
+			vF = SSW_SUBS_EPU16(vF, vGapE);
+			vF = SSW_MAX_EPI16(vF, vH);
+
+			/* Load the next vH. */
+			vH = SSW_LOAD(pvHLoad + j);
+		}
+
+		/* Lazy_F loop: disallow adjecent insertion and then deletion, so don't update E(i, j) */
+		for (k = 0; LIKELY(k < SSW_LANES_WORD); ++k) {
+			vF = SSW_SHIFT_LEFT(vF, 2);
+			for (j = 0; LIKELY(j < segLen); ++j) {
+				vH = SSW_LOAD(pvHStore + j);
+				vH = SSW_MAX_EPI16(vH, vF);
+				SSW_STORE(pvHStore + j, vH);
+				vH = SSW_SUBS_EPU16(vH, vGapO);
+				vF = SSW_SUBS_EPU16(vF, vGapE);
+				if (UNLIKELY(!SSW_ANY_GT_EPI16(vF, vH))) goto end;
+			}
+		}
+
+end:
+		vMaxScore = SSW_MAX_EPI16(vMaxScore, vMaxColumn);
+		if (!SSW_IS_ZERO(SSW_XOR(vMaxMark, vMaxScore))) {
+			uint16_t temp;
+			vMaxMark = vMaxScore;
+			vReduced = SSW_REDUCE_EPI16(vMaxScore);
+			ssw_hmax_epi16(temp, vReduced);
+
+			if (LIKELY(temp > max)) {
+				max = temp;
+				end_ref = i;
+				for (j = 0; LIKELY(j < segLen); ++j) pvHmax[j] = pvHStore[j];
+			}
+		}
+
+		/* Record the max score of current column. */
+		vReduced = SSW_REDUCE_EPI16(vMaxColumn);
+		ssw_hmax_epi16(maxColumn[i], vReduced);
+		if (maxColumn[i] == terminate) break;
+	}
+
+	/* Trace the alignment ending position on read. */
+	uint16_t *t = (uint16_t*)pvHmax;
+	int32_t column_len = segLen * SSW_LANES_WORD;
+	for (i = 0; LIKELY(i < column_len); ++i, ++t) {
+		int32_t temp;
+		if (*t == max) {
+			temp = i / SSW_LANES_WORD + i % SSW_LANES_WORD * segLen;
+			if (temp < end_read) end_read = temp;
+		}
+	}
+
+	free(pvMask);
+	free(pvHmax);
+	free(pvE);
+	free(pvHLoad);
+	free(pvHStore);
+
+	/* Find the most possible 2nd best alignment. */
+	alignment_end* bests = (alignment_end*) calloc(2, sizeof(alignment_end));
+	bests[0].score = max;
+	bests[0].ref = end_ref;
+	bests[0].read = end_read;
+
+	bests[1].score = 0;
+	bests[1].ref = 0;
+	bests[1].read = 0;
+
+	edge = (end_ref - maskLen) > 0 ? (end_ref - maskLen) : 0;
+	for (i = 0; i < edge; i ++) {
+		if (maxColumn[i] > bests[1].score) {
+			bests[1].score = maxColumn[i];
+			bests[1].ref = i;
+		}
+	}
+	edge = (end_ref + maskLen) > refLen ? refLen : (end_ref + maskLen);
+	for (i = edge; i < refLen; i ++) {
+		if (maxColumn[i] > bests[1].score) {
+			bests[1].score = maxColumn[i];
+			bests[1].ref = i;
+		}
+	}
+
+	free(maxColumn);
+	return bests;
+}